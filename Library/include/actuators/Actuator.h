@@ -55,6 +55,18 @@ namespace sf
          */
         virtual void Update(Scalar dt);
         
+        //! A method saving the dynamic state of the actuator.
+        /*!
+         \param state a buffer to which the state is appended
+         */
+        virtual void SaveState(StateBuffer& state) const;
+        
+        //! A method restoring the dynamic state of the actuator.
+        /*!
+         \param state a reader of the buffer written by the same actuator
+         */
+        virtual void RestoreState(StateReader& state);
+        
         //! A method implementing the rendering of the actuator.
         virtual std::vector<Renderable> Render();
         
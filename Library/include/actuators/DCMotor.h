@@ -51,6 +51,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method to setup a simulated gearbox connected to the motor.
         /*!
          \param enable a flag to indicate if the gearbox should be enabled
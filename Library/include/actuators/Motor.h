@@ -46,6 +46,9 @@ namespace sf
          */
         virtual void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method to set the motor torque.
         /*!
          \param tau a value of the motor torque [Nm]
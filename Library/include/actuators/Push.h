@@ -47,6 +47,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method implementing the rendering of the push actuator.
         std::vector<Renderable> Render();
         
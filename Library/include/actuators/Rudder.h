@@ -57,6 +57,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method implementing the rendering of the rudder.
         std::vector<Renderable> Render();
         
@@ -65,6 +65,9 @@ namespace sf
          */
         virtual void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method to set the desired control mode.
         /*!
          \param m control mode
@@ -67,6 +67,9 @@ namespace sf
          */
         void Update(Scalar dt);
 
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //!
         void Engage(SimulationManager* sm);
         
@@ -56,6 +56,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method implementing the rendering of the thruster.
         std::vector<Renderable> Render();
         
@@ -49,6 +49,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method implementing the rendering of the VBS.
         std::vector<Renderable> Render();
         
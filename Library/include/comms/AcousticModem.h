@@ -66,6 +66,9 @@ namespace sf
          */
         virtual void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to update position of the modem based on measurements from USBL or another device.
         /*!
          \param pos Cartesian position [m]
@@ -98,6 +101,8 @@ namespace sf
         
     protected:
         virtual void ProcessMessages();
+        void SaveFrame(StateBuffer& state, const CommDataFrame* frame) const override;
+        CommDataFrame* RestoreFrame(StateReader& state) const override;
         
         static AcousticModem* getNode(uint64_t deviceId);
         
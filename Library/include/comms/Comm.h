@@ -28,6 +28,7 @@
 
 #include <SDL2/SDL_mutex.h>
 #include <deque>
+#include <random>
 #include "StonefishCommon.h"
 
 namespace sf
@@ -39,6 +40,8 @@ namespace sf
     class Entity;
     class StaticEntity;
     class MovingEntity;
+    class StateBuffer;
+    class StateReader;
     
     struct CommDataFrame
     {
@@ -110,6 +113,18 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        //! A method saving the dynamic state of the comm device.
+        /*!
+         \param state a buffer to which the state is appended
+         */
+        virtual void SaveState(StateBuffer& state) const;
+        
+        //! A method restoring the dynamic state of the comm device.
+        /*!
+         \param state a reader of the buffer written by the same comm device
+         */
+        virtual void RestoreState(StateReader& state);
+        
         //! A method used to mark data as old.
         void MarkDataOld();
         
@@ -134,6 +149,12 @@ namespace sf
         //! A method returning the comm name.
         std::string getName();
         
+        //! A method to seed the noise generator of the comm.
+        /*!
+         \param seed the seed value
+         */
+        void setRandomSeed(unsigned int seed);
+        
         //! A method performing an internal update of the comm state.
         /*!
          \param dt the time step of the simulation [s]
@@ -148,11 +169,16 @@ namespace sf
         void MessageReceived(CommDataFrame* message);
         //! A method to proccess received messages.
         virtual void ProcessMessages() = 0;
+        //! A method used to save a data frame.
+        virtual void SaveFrame(StateBuffer& state, const CommDataFrame* frame) const;
+        //! A method used to restore a data frame.
+        virtual CommDataFrame* RestoreFrame(StateReader& state) const;
     
         bool newDataAvailable;
         std::deque<CommDataFrame*> txBuffer;
         std::deque<CommDataFrame*> rxBuffer;
         uint64_t txSeq;
+        std::mt19937 randomGenerator;
         
     private:
         std::string name;
@@ -62,6 +62,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to enable the auto pinging of connected transponder to monitor its position.
         /*!
          \param rate how often the ping should be sent (0 for continuous mode) [Hz]
@@ -85,9 +88,6 @@ namespace sf
         Scalar pingTime;
         std::map<uint64_t, BeaconInfo> beacons;
         bool noise;
-        
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
     };
 }
     
@@ -0,0 +1,98 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BatchSimulationApp.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_BatchSimulationApp__
+#define __Stonefish_BatchSimulationApp__
+
+#include <SDL2/SDL_thread.h>
+#include <functional>
+#include "core/SimulationApp.h"
+
+namespace sf
+{
+    //! A class that defines a console application hosting many independent simulation worlds, stepped in parallel.
+    class BatchSimulationApp : public SimulationApp
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param name a name for the application
+         \param dataDirPath a path to the directory containing the simulation data
+         \param worlds a list of simulation managers, each representing an independent world
+         \param numThreads number of worker threads used to step the worlds (0 = all available)
+         \param stepsPerBatch number of simulation steps computed by each world in one batch
+         */
+        BatchSimulationApp(std::string name, std::string dataDirPath, const std::vector<SimulationManager*>& worlds, 
+                           unsigned int numThreads = 0, unsigned int stepsPerBatch = 1);
+        
+        //! A destructor.
+        virtual ~BatchSimulationApp();
+        
+        //! A method advancing all worlds by an exact number of simulation steps, in parallel.
+        /*!
+         \param steps number of simulation steps to compute in each world
+         */
+        void StepWorlds(unsigned int steps);
+        
+        //! A method informing if the application is graphical.
+        bool hasGraphics();
+        
+        //! A method returning the number of simulated worlds.
+        size_t getNumOfWorlds() const;
+        
+        //! A method returning a simulated world by index.
+        /*!
+         \param index an id of the world
+         \return a pointer to the simulation manager of the world
+         */
+        SimulationManager* getWorld(size_t index);
+        
+    protected:
+        void Init();
+        void LoopInternal();
+        void InitializeSimulation();
+        void StartSimulation();
+        void ResumeSimulation();
+        void StopSimulation();
+        
+    private:
+        void ForEachWorld(const std::function<void(SimulationManager*)>& func, size_t first = 0);
+        
+        std::vector<SimulationManager*> worlds;
+        int nThreads;
+        unsigned int batchSteps;
+        SDL_Thread* simulationThread;
+        static int RunSimulation(void* data);
+    };
+    
+    //! A structure used to pass information between threads.
+    typedef struct
+    {
+        BatchSimulationApp* app;
+    }
+    BatchSimulationThreadData;
+}
+
+#endif
@@ -30,6 +30,8 @@
 
 namespace sf
 {
+    class SimulationManager;
+    
     //! A class implementing a custom collision dispatcher object.
     class FilteredCollisionDispatcher : public btCollisionDispatcher
     {
@@ -37,9 +39,10 @@ namespace sf
         //! A constructor.
         /*!
          \param collisionConfiguration a pointer to the collision configuration structure
+         \param sm a pointer to the simulation manager owning the collision filter
          \param inclusiveMode a flag that selects the mode of collision detection
          */
-        FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, bool inclusiveMode);
+        FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, SimulationManager* sm, bool inclusiveMode);
         
         //! A method that informs if two collision objects can collide.
         /*!
@@ -58,6 +61,7 @@ namespace sf
         static void myNearCallback(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo);
         
     private:
+        SimulationManager* sim;
         bool inclusive;
     };
 }
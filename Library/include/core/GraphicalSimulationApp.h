@@ -37,6 +37,7 @@ namespace sf
     class OpenGLPipeline;
     class Entity;
     class MovingEntity;
+    struct TickProfilerEntry;
     
     //! A class that implements an interface of a graphical application.
     class GraphicalSimulationApp : public SimulationApp
@@ -204,6 +205,9 @@ namespace sf
         bool displayKeymap;
         bool displayConsole;
         bool displayPerformance;
+        std::vector<TickProfilerEntry> profilerSummary;
+        std::vector<std::pair<std::string, double>> profilerCounters;
+        int64_t profilerSummaryTime;
         std::string shaderPath;
         bool loading;
         double drawingTime;
@@ -225,7 +229,6 @@ namespace sf
     typedef struct
     {
         GraphicalSimulationApp* app;
-        SDL_mutex* drawingQueueMutex;
     }
     GraphicalSimulationThreadData;
     
@@ -0,0 +1,71 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayQuery.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_RayQuery__
+#define __Stonefish_RayQuery__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    class Entity;
+    
+    //! A structure holding a batch of rays to be tested against the simulation world.
+    struct RayBatch
+    {
+        std::vector<Vector3> from;
+        std::vector<Vector3> to;
+        
+        //! A method adding a ray to the batch.
+        /*!
+         \param rayFrom the start point of the ray in the world frame
+         \param rayTo the end point of the ray in the world frame
+         */
+        void AddRay(const Vector3& rayFrom, const Vector3& rayTo) { from.push_back(rayFrom); to.push_back(rayTo); }
+        
+        //! A method removing all rays from the batch (keeps the memory).
+        void Clear() { from.clear(); to.clear(); }
+        
+        //! A method returning the number of rays in the batch.
+        size_t size() const { return from.size(); }
+    };
+    
+    //! A structure holding the results of a batch of ray tests, in flat arrays.
+    struct RayHits
+    {
+        std::vector<Scalar> fraction; //Fraction of the ray length at the closest hit (1 -> no hit)
+        std::vector<Vector3> normal; //Surface normal at the closest hit, in the world frame
+        std::vector<Entity*> entity; //Entity hit by the ray (nullptr if none)
+        
+        //! A method informing if a ray hit anything.
+        /*!
+         \param i the index of the ray
+         \return true if the ray hit an object
+         */
+        bool hasHit(size_t i) const { return fraction[i] < Scalar(1); }
+    };
+}
+
+#endif
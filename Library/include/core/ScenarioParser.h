@@ -78,6 +78,18 @@ namespace sf
         //! A method used to get the pointer to the associated simulation manager.
         SimulationManager* getSimulationManager();
 
+        //! A static method used to enable caching of the pre-processed scenario files.
+        /*!
+         When enabled, each scenario file is loaded and pre-processed (arguments replaced and expressions evaluated)
+         only once for each set of arguments, and the result is reused by all parsers, e.g., when the scenario is restarted.
+         A cached file is loaded again only when it is modified. The processed geometry of the bodies is also kept in memory.
+         \param enabled a flag indicating if the cache should be used
+         */
+        static void EnableScenarioCache(bool enabled);
+
+        //! A static method used to free the cached scenario files and the unused geometry.
+        static void ClearScenarioCache();
+
     protected:
         Console log;
 
@@ -278,6 +290,9 @@ namespace sf
 
     private:
         bool CopyNode(XMLNode* destParent, const XMLNode* src);
+        std::string GetCacheKey(const std::string& path, const std::map<std::string, std::string>& args);
+        bool RestoreFromCache(const std::string& path, const std::map<std::string, std::string>& args, XMLDocument& target, std::string& stamp);
+        void StoreInCache(const std::string& path, const std::map<std::string, std::string>& args, const std::string& stamp, const XMLDocument& source);
         bool ParseVector(const char* components, Vector3& v);
         bool ParseTransform(XMLElement* element, Transform& T);
         bool ParseColor(XMLElement* element, Color& c);
@@ -63,7 +63,7 @@ namespace sf
         //! A method informing if the application is graphical.
         virtual bool hasGraphics() = 0;
         
-        //! A method returning a pointer to the simulation manager.
+        //! A method returning a pointer to the simulation manager (the one bound to the calling thread, if any).
         SimulationManager* getSimulationManager();
         
         //! A method returning the physics computation time.
@@ -81,12 +81,32 @@ namespace sf
         //! A method returning the name of the application.
         std::string getName();
         
+        //! A method to set the directory used to store processed data between runs.
+        /*!
+         The processed geometry and the compiled shader programs are stored in subdirectories. The method has to be called
+         before the application is run. By default "$XDG_CACHE_HOME/stonefish" or "$HOME/.cache/stonefish" is used.
+         \param path a path to the cache directory (empty to disable the cache)
+         */
+        void setCacheDirectory(const std::string& path);
+        
+        //! A method returning the path to the directory used to store processed data between runs.
+        std::string getCacheDirectory();
+        
         //! A method returning a pointer to the console associated with the application.
         Console* getConsole();
         
         //! A static method returning the pointer to the currently running application.
         static SimulationApp* getApp();
         
+        //! A static method binding a simulation manager to the calling thread (per-world context).
+        /*!
+         \param sim a pointer to the simulation manager that should be used by the calling thread (nullptr to use the default one)
+         */
+        static void setThreadSimulationManager(SimulationManager* sim);
+        
+        //! A static method returning the simulation manager bound to the calling thread (nullptr if none).
+        static SimulationManager* getThreadSimulationManager();
+        
     protected:
         void Loop();
 
@@ -107,11 +127,13 @@ namespace sf
         SimulationManager* simulation;
         std::string appName;
         std::string dataPath;
+        std::string cacheDir;
         bool finished;
         bool running;
         double physicsTime;
         
         static SimulationApp* handle;
+        static thread_local SimulationManager* threadSimulation;
     };
 }
 
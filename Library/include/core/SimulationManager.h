@@ -26,11 +26,14 @@
 #ifndef __Stonefish_SimulationManager__
 #define __Stonefish_SimulationManager__
 
+#include <unordered_map>
 #include "StonefishCommon.h"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
 #include "entities/SolidEntity.h"
 #include "utils/PerformanceMonitor.h"
+#include "utils/StateBuffer.h"
+#include "core/RayQuery.h"
 
 namespace sf
 {
@@ -65,6 +68,36 @@ namespace sf
         Entity* B;
     };
     
+    //! A type representing an unordered pair of entities (stored with the lower address first).
+    typedef std::pair<const Entity*, const Entity*> EntityPair;
+    
+    //! A hash function object used to index entity pairs.
+    struct EntityPairHash
+    {
+        size_t operator()(const EntityPair& p) const
+        {
+            size_t h = std::hash<const Entity*>()(p.first);
+            return h ^ (std::hash<const Entity*>()(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
+    
+    //! A structure holding a snapshot of the dynamic state of the simulation world.
+    /*!
+     The snapshot is kept in memory and can only be restored in the same scenario instance.
+     The buffer is reused when the snapshot is saved again, to avoid allocations.
+     */
+    struct SimulationSnapshot
+    {
+        StateBuffer state;
+        size_t numOfEntities;
+        size_t numOfActuators;
+        size_t numOfSensors;
+        size_t numOfComms;
+        
+        //! A constructor.
+        SimulationSnapshot() : numOfEntities(0), numOfActuators(0), numOfSensors(0), numOfComms(0) {}
+    };
+    
     //! An abstract class managing the simulation world, the solver settings and implementing custom physics callbacks.
     class SimulationManager
     {
@@ -122,6 +155,25 @@ namespace sf
         //! A method computing the next simulation step.
         void AdvanceSimulation();
         
+        //! A method advancing the simulation by an exact number of fixed steps, without reading the clock or sleeping.
+        /*!
+         \param steps number of simulation steps to compute
+         */
+        void StepSimulation(unsigned int steps = 1);
+        
+        //! A method saving the dynamic state of the simulation world.
+        /*!
+         \param snapshot a reference to the snapshot that will be overwritten
+         */
+        void SaveSnapshot(SimulationSnapshot& snapshot);
+        
+        //! A method restoring the dynamic state of the simulation world, without rebuilding the scenario.
+        /*!
+         \param snapshot a reference to the snapshot saved in the same scenario
+         \return success
+         */
+        bool RestoreSnapshot(const SimulationSnapshot& snapshot);
+        
         //! A method updating the drawing queue (thread safe)
         void UpdateDrawingQueue();
         
@@ -253,6 +305,15 @@ namespace sf
          */
         std::pair<Entity*, int> PickEntity(Vector3 eye, Vector3 ray);
         
+        //! A method testing a batch of rays against the simulation world, returning the closest hits.
+        /*!
+         Large batches are processed in parallel. Each thread traverses the broadphase tree using its own stack.
+         \param rays a batch of rays
+         \param hits a structure to store the results (resized to the size of the batch)
+         \param filterMask a mask defining the types of objects that should be tested
+         */
+        void RayTest(const RayBatch& rays, RayHits& hits, int filterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING) const;
+        
         //! A method that sets new valve for the amount of simulation steps in a second.
         /*!
          \param steps number steps of simulation per second
@@ -265,6 +326,30 @@ namespace sf
          */
         void setRealtimeFactor(Scalar f);
         
+        //! A method that switches the simulation to the free-running (lock-step) mode.
+        /*!
+         \param enabled a flag indicating if the simulation should run as fast as possible, ignoring the simulation clock
+         */
+        void setFreeRunning(bool enabled);
+        
+        //! A method that switches the adaptive scheduling of the geometry-based hydrodynamics.
+        /*!
+         \param enabled a flag indicating if the hydrodynamic forces should be recomputed for each body based on its motion, instead of at a fixed rate
+         */
+        void setAdaptiveHydrodynamics(bool enabled);
+        
+        //! A method setting the thresholds of the adaptive scheduling of the geometry-based hydrodynamics.
+        /*!
+         \param settings a structure holding the thresholds
+         */
+        void setAdaptiveHydrodynamicsSettings(const AdaptiveHydrodynamicsSettings& settings);
+        
+        //! A method setting the seed of the noise generators of the sensors and comms.
+        /*!
+         \param seed a seed from which the seeds of the individual sensors and comms are derived, based on the order in which they were added
+         */
+        void setRandomSeed(unsigned int seed);
+        
         //! A method used to setup the initial conditions solver.
         /*!
          \param useGravity specifies if gravity should be enabled during IC solving
@@ -451,6 +536,18 @@ namespace sf
         //! A method informing about the relation between the simulated time and real time.
         Scalar getRealtimeFactor() const;
         
+        //! A method informing if the simulation is running in the free-running (lock-step) mode.
+        bool isFreeRunning() const;
+        
+        //! A method informing if the geometry-based hydrodynamics is scheduled adaptively.
+        bool isAdaptiveHydrodynamics() const;
+        
+        //! A method returning the thresholds of the adaptive scheduling of the geometry-based hydrodynamics.
+        AdaptiveHydrodynamicsSettings getAdaptiveHydrodynamicsSettings() const;
+        
+        //! A method returning the seed of the noise generators.
+        unsigned int getRandomSeed() const;
+        
         //! A method returning a pointer to the material manager.
         MaterialManager* getMaterialManager();
         
@@ -535,6 +632,13 @@ namespace sf
         void RenderBulletDebug();
         void InitializeSolver();
         void InitializeScenario();
+        void UpdateSolverStatistics(uint64_t deltaTime);
+        void UpdateSensorSchedule();
+        void UpdateSensors(Scalar dt);
+        void CollectBodiesInFluid(ForcefieldEntity* fluid, std::vector<std::pair<SolidEntity*, bool>>& bodies);
+        void RemoveCollision(size_t index);
+        unsigned int DeriveSeed(size_t index, bool comm = false) const;
+        static EntityPair MakeEntityPair(const Entity* entA, const Entity* entB);
         
         // State
         Scalar simulationTime;
@@ -545,9 +649,15 @@ namespace sf
         // Performance
         PerformanceMonitor perfMon;
         Scalar realtimeFactor;
+        bool freeRunning;
         Scalar cpuUsage;
         unsigned int fdPrescaler;
         unsigned int fdCounter;
+        bool hydroAdaptive;
+        AdaptiveHydrodynamicsSettings hydroAdaptiveSettings;
+        unsigned int randomSeed;
+        std::vector<std::pair<SolidEntity*, bool>> aeroBodies; //Bodies in the atmosphere (body, recompute)
+        std::vector<std::pair<SolidEntity*, bool>> hydroBodies; //Bodies in the ocean (body, recompute)
         
         // Threading
         SDL_mutex* simSettingsMutex;
@@ -579,10 +689,18 @@ namespace sf
         std::vector<Entity*> entities;
         std::vector<Joint*> joints;
         std::vector<Sensor*> sensors;
+        std::vector<Sensor*> serialSensors;
+        std::vector<Sensor*> sensorOrder;
+        std::vector<int> sensorStageEnds;
+        std::vector<std::string> sensorNames;
+        std::vector<double> sensorTimes;
+        bool sensorScheduleValid;
         std::vector<Actuator*> actuators;
         std::vector<Comm*> comms;
         std::vector<Contact*> contacts;
+        std::unordered_map<EntityPair, Contact*, EntityPairHash> contactIndex;
         std::vector<Collision> collisions;
+        std::unordered_map<EntityPair, size_t, EntityPairHash> collisionIndex;
         NED* ned;
         Ocean* ocean;
         Atmosphere* atmosphere;
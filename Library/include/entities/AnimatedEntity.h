@@ -149,6 +149,9 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method returning the elements that should be rendered.
         std::vector<Renderable> Render();
         
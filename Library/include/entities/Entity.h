@@ -52,6 +52,8 @@ namespace sf
     
     struct Renderable;
     class SimulationManager;
+    class StateBuffer;
+    class StateReader;
     
     //! An abstract class representing a simulation entity.
     class Entity
@@ -97,6 +99,18 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max) = 0;
         
+        //! A method saving the dynamic state of the entity.
+        /*!
+         \param state a buffer to which the state is appended
+         */
+        virtual void SaveState(StateBuffer& state) const;
+        
+        //! A method restoring the dynamic state of the entity.
+        /*!
+         \param state a reader of the buffer written by the same entity
+         */
+        virtual void RestoreState(StateReader& state);
+        
     private:
         bool renderable;
         std::string name;
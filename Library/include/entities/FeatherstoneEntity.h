@@ -204,6 +204,16 @@ namespace sf
          */
         void UpdateAcceleration(Scalar dt);
         
+        //! A method computing the velocities of all links and caching them in the link bodies.
+        /*!
+         The velocities are propagated from the base along the kinematic tree, in a single pass.
+         It is called by the simulation manager once per step and by the methods changing the state of the multibody.
+         */
+        void UpdateKinematics();
+        
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to set the initial conditions for a joint.
         /*!
          \param index an id of the joint
@@ -401,6 +411,9 @@ namespace sf
         std::vector<FeatherstoneLink> links;
         std::vector<FeatherstoneJoint> joints;
         bool baseRenderable;
+        btAlignedObjectArray<Vector3> linkOmega; //Scratch buffers of the kinematics pass
+        btAlignedObjectArray<Vector3> linkVel;
+        btAlignedObjectArray<Quaternion> worldToLink;
     };
 }
 
@@ -72,6 +72,13 @@ namespace sf
         //! A method returning the type of the entity.
         EntityType getType() const;
         
+        //! A static method returning the entity owning a dynamic collision object.
+        /*!
+         \param co a pointer to the collision object
+         \return a pointer to the entity or nullptr if the object is static, kinematic or unknown
+         */
+        static Entity* getDynamicEntity(const btCollisionObject* co);
+        
     protected:
         btPairCachingGhostObject* ghost;
     };
@@ -60,7 +60,32 @@ namespace sf
         }
     };
 
+    //! A structure holding a copy of the physics mesh in a structure-of-arrays layout, used by the vectorised fluid dynamics kernels.
+    struct HydroMesh
+    {
+        //! Number of faces processed in one iteration of the kernels (face arrays are padded to its multiple).
+        static constexpr size_t laneWidth = 8;
+        
+        std::vector<GLfloat> vx, vy, vz; //Vertex positions (physics frame)
+        glm::vec3 aabbMin, aabbMax; //Bounding box of the vertices (physics frame)
+        std::vector<GLuint> f0, f1, f2; //Vertex indices of the faces
+        std::vector<GLfloat> cx, cy, cz; //Face centroids (physics frame)
+        std::vector<GLfloat> nx, ny, nz; //Unit face normals (physics frame)
+        std::vector<GLfloat> area; //Face areas (zero for padding)
+        size_t nFaces; //Number of valid faces
+        
+        //! A constructor.
+        /*!
+         \param mesh a pointer to the mesh to be converted (degenerate faces are skipped)
+         */
+        HydroMesh(const Mesh* mesh);
+        
+        //! A method returning the number of faces including padding.
+        size_t getNumOfPaddedFaces() const { return area.size(); }
+    };
+    
     struct HydrodynamicsSettings;
+    struct AdaptiveHydrodynamicsSettings;
     class Ocean;
     class Atmosphere;
     
@@ -112,6 +137,9 @@ namespace sf
          */
         void UpdateAcceleration(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method that computes fluid dynamics based on selected settings.
         /*!
          \param settings a structure holding settings of fluid dynamics computation
@@ -119,6 +147,17 @@ namespace sf
          */
         virtual void ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean* ocn);
         
+        //! A method deciding if the geometry-based fluid dynamics should be recomputed in the current step.
+        /*!
+         The computation is skipped for sleeping and quasi-static bodies and repeated more often
+         for bodies crossing the surface or experiencing a fast change of the relative flow.
+         \param ocn a pointer to the ocean entity
+         \param basePeriod the nominal number of steps between computations
+         \param settings the thresholds of the scheduling
+         \return true if the fluid dynamics should be recomputed
+         */
+        bool UpdateHydrodynamicsSchedule(Ocean* ocn, unsigned int basePeriod, const AdaptiveHydrodynamicsSettings& settings);
+        
         //! A method that corrects damping forces based on geometry approximation
         /*!
          \param ocn a pointer to the fluid entity generating forces (currently only Ocean supported)
@@ -132,7 +171,7 @@ namespace sf
         //! A static method that computes fluid dynamics when a body is crossing the fluid surface.
         /*!
          \param settings a reference to a structure holding settings of the fluid dynamics computation
-         \param mesh a pointer to the body physics mesh data
+         \param hmesh a pointer to the body physics mesh data in the structure-of-arrays layout
          \param liquid a pointer to the fluid entity generating forces (currently only Ocean supported)
          \param T_CG a transform from the world frame to the body CG frame
          \param T_C a transform from the world frame to the physics frame
@@ -148,7 +187,7 @@ namespace sf
          \param _Vsub output of the submerged volume
          \param debug output of the debug rendering
         */
-        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const HydroMesh* hmesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                      const Vector3& linearV, const Vector3& angularV, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
                                                      Scalar& _Swet, Scalar& _Vsub, Renderable& debug);
         
@@ -168,6 +207,22 @@ namespace sf
         static void ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                        const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf);
         
+        //! A static method that computes fluid dynamics when a body is completely submerged (vectorised version).
+        /*!
+         \param hmesh a pointer to the body physics mesh data in the structure-of-arrays layout
+         \param liquid a pointer to the fluid entity generating forces
+         \param T_CG a transform from the world frame to the body CG frame
+         \param T_C a transform from the world frame to the body physics frame
+         \param linearV the linear velocity of the body in the world frame
+         \param angularV the angular velocity of the body in the world frame
+         \param _Fdq output of the damping force resulting from form drag
+         \param _Tdq output of the torque induced by form drag
+         \param _Fdf output of the damping force resulting from skin friction
+         \param _Tdf output of the torque induced by skin friction
+        */
+        static void ComputeHydrodynamicForcesSubmerged(const HydroMesh* hmesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+                                                       const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf);
+        
         //! A method that computes aerodynamics.
         /*!
          \param atm a pointer to the atmosphere entity
@@ -249,6 +304,16 @@ namespace sf
          */
         void SetHydrodynamicCoefficients(const Vector3& Cd, const Vector3& Cf);
         
+        //! A method used to set the level of detail of the mesh used in the hydrodynamics computation.
+        /*!
+         The physics mesh is welded and decimated until one of the limits is reached. The rendering and the collisions are not affected.
+         Decimation changes the volume enclosed by the mesh, so the buoyancy of a body crossing the surface no longer matches
+         the volume of the original mesh, which is still used when the body is fully submerged.
+         \param maxFaces the number of faces at which decimation stops (0 for no limit)
+         \param maxError the maximum geometric error introduced by decimation [m] (0 for no limit)
+         */
+        void setHydrodynamicsMeshLOD(size_t maxFaces, Scalar maxError);
+        
         //! A method to set the body pose in the world frame.
         void setCGTransform(const Transform& trans);
         
@@ -366,6 +431,15 @@ namespace sf
         
         //! A method returning a pointer to the physics mesh.
         const Mesh* getPhysicsMesh();
+        
+        //! A method that builds the mesh used in the hydrodynamics computation, applying the level of detail settings.
+        /*!
+         Called when the body is built, so that welding and decimation never run inside a simulation step.
+         */
+        virtual void BuildHydrodynamicsMesh();
+        
+        //! A method returning a pointer to the physics mesh in the structure-of-arrays layout (nullptr before the body is built).
+        const HydroMesh* getHydroMesh();
 
         //! A method that returns a copy of all physics mesh vertices in body origin frame.
         virtual std::vector<Vector3>* getMeshVertices() const;
@@ -402,6 +476,7 @@ namespace sf
         void ComputeSphericalApprox();
         void ComputeCylindricalApprox();
         void ComputeEllipsoidalApprox();
+        void SetEllipsoidalApprox(const Vector3& axes);
         
         Scalar LambKFactor(Scalar r1, Scalar r2);
         virtual void BuildRigidBody();
@@ -409,8 +484,13 @@ namespace sf
         
         //Body
         btMultiBodyLinkCollider* multibodyCollider;
+        Vector3 linkLinearVelocity; //World frame velocities of the multibody link, updated by FeatherstoneEntity::UpdateKinematics()
+        Vector3 linkAngularVelocity;
         
         Mesh* phyMesh; //Mesh used for physics calculation
+        HydroMesh* hydroMesh; //Copy of physics mesh used by vectorised fluid dynamics
+        size_t hydroMaxFaces;
+        Scalar hydroMaxError;
         Scalar thick;
         Scalar volume;
         Scalar surface;
@@ -448,6 +528,11 @@ namespace sf
         Vector3 Tdf;
         Scalar Swet; //Wetted surface of the body
         Scalar Vsub; //Submerged part of body
+        BodyFluidPosition hydroPosition; //Position with respect to the fluid, at the last computation of hydrodynamics
+        unsigned int hydroSteps; //Steps since the last computation of hydrodynamics
+        Vector3 hydroFlowV; //Relative flow velocity at the last computation of hydrodynamics
+        Vector3 hydroOmega; //Angular velocity at the last computation of hydrodynamics
+        bool hydroComputed;
         
         Vector3 Fda;
         Vector3 Tda;
@@ -51,6 +51,9 @@ namespace sf
         //! A method updating the interpolated transform and velocities.
         void Interpolate();
 
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+
         //! A method that builds a graphical representation of the trajectory.
         void BuildGraphicalPath();
 
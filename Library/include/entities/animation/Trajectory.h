@@ -31,6 +31,9 @@
 
 namespace sf
 {
+    class StateBuffer;
+    class StateReader;
+    
     //! An enum representing available trajectory playback modes.
     enum class PlaybackMode {ONETIME, REPEAT, BOOMERANG};
 
@@ -77,6 +80,18 @@ namespace sf
         //! A method returning the current playback iteration.
         unsigned int getPlaybackIteration() const;
 
+        //! A method saving the dynamic state of the trajectory.
+        /*!
+         \param state a buffer to which the state is appended
+         */
+        virtual void SaveState(StateBuffer& state) const;
+
+        //! A method restoring the dynamic state of the trajectory.
+        /*!
+         \param state a reader of the buffer written by the same trajectory
+         */
+        virtual void RestoreState(StateReader& state);
+
         static void calculateVelocityShortestPath(const Transform &transform0, const Transform &transform1, Scalar timeStep, Vector3 &linVel, Vector3 &angVel);
     
     protected:
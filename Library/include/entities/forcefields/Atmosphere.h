@@ -34,6 +34,7 @@
 namespace sf
 {
     class VelocityField;
+    class SolidEntity;
     class OpenGLAtmosphere;
     struct RenderSettings;
     
@@ -86,6 +87,20 @@ namespace sf
          */
         void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
         
+        //! A method running the aerodynamics computation for a single body, without applying the forces.
+        /*!
+         Bodies are independent, so the computation can run in parallel.
+         \param solid a pointer to the body
+         */
+        void ComputeFluidForces(SolidEntity* solid);
+        
+        //! A method applying the last computed aerodynamic forces to a single body.
+        /*!
+         \param solid a pointer to the body
+         \param recompute a flag deciding if aerodynamic forces need to be recomputed
+         */
+        void ApplyFluidForces(SolidEntity* solid, bool recompute);
+        
         //! A method returning the position of the sun in the sky.
         /*!
          \param azimuthDeg a reference to the variable that will store the azimuth of the sun [deg]
@@ -40,8 +40,24 @@ namespace sf
         bool reallisticBuoyancy;
     };
     
+    //! A structure holding the thresholds of the adaptive scheduling of the hydrodynamics computation.
+    struct AdaptiveHydrodynamicsSettings
+    {
+        Scalar quasiStaticSpeed; //!< Relative flow speed below which a body is quasi-static [m/s]
+        Scalar quasiStaticChange; //!< Change of the relative flow below which a body is quasi-static [m/s]
+        unsigned int quasiStaticFactor; //!< Multiplier of the nominal period for quasi-static bodies
+        Scalar minChange; //!< Change of the relative flow which always triggers recomputation [m/s]
+        Scalar relativeChange; //!< Change of the relative flow triggering recomputation, as a fraction of the flow speed
+        
+        //! A constructor setting the default thresholds.
+        AdaptiveHydrodynamicsSettings() : quasiStaticSpeed(Scalar(0.01)), quasiStaticChange(Scalar(0.005)), quasiStaticFactor(8),
+                                          minChange(Scalar(0.02)), relativeChange(Scalar(0.05)) {}
+    };
+    
     class VelocityField;
     class Actuator;
+    class SpectralWaves;
+    class SolidEntity;
     
     //! A class implementing an ocean.
     class Ocean : public ForcefieldEntity
@@ -72,6 +88,20 @@ namespace sf
          */
         void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
         
+        //! A method running the hydrodynamics computation for a single body, without applying the forces.
+        /*!
+         Bodies are independent, so the computation can run in parallel.
+         \param solid a pointer to the body
+         */
+        void ComputeFluidForces(SolidEntity* solid);
+        
+        //! A method applying the last computed hydrodynamic forces to a single body.
+        /*!
+         \param solid a pointer to the body
+         \param recompute a flag deciding if hydrodynamic forces need to be recomputed
+         */
+        void ApplyFluidForces(SolidEntity* solid, bool recompute);
+        
         //! A method returning the water velocity.
         /*!
          \param point the point in the ocean where the velocity should be measured [m]
@@ -80,6 +110,14 @@ namespace sf
         Vector3 GetFluidVelocity(const Vector3& point) const;
         glm::vec3 GetFluidVelocity(const glm::vec3& point) const;
         
+        //! A method returning the water velocity at multiple points.
+        /*!
+         \param xyz an array of point coordinates (x,y,z interleaved) [m]
+         \param out an array of fluid velocities (x,y,z interleaved) [m/s]
+         \param count the number of points
+         */
+        void GetFluidVelocity(const GLfloat* xyz, GLfloat* out, size_t count) const;
+        
         //! A method checking if a point is inside fluid
         /*!
          \param point the position of a point to be checked [m]
@@ -102,6 +140,20 @@ namespace sf
         Scalar GetDepth(const Vector3& point);
         GLfloat GetDepth(const glm::vec3& point);
         
+        //! A method returning the depth of the ocean at multiple points.
+        /*!
+         \param xyz an array of point coordinates (x,y,z interleaved) [m]
+         \param depths an array of distances from the points to the surface of fluid [m]
+         \param count the number of points
+         */
+        void GetDepth(const GLfloat* xyz, GLfloat* depths, size_t count);
+        
+        //! A method updating the CPU wave model, used when graphics is not available.
+        /*!
+         \param t the simulation time [s]
+         */
+        void UpdateWaves(Scalar t);
+        
         //! A method to enable all defined currents.
         void EnableCurrents();
         
@@ -109,7 +161,13 @@ namespace sf
         void DisableCurrents();
 
         //! A method updating the currents data in the OpenGL ocean.
-        void UpdateCurrentsData();
+        /*!
+         \param data the currents data published together with the drawing queue
+         */
+        void UpdateCurrentsData(const OceanCurrentsUBO& data);
+        
+        //! A method returning the currents data built when the ocean was last rendered.
+        const OceanCurrentsUBO& getCurrentsData() const;
         
         //! A method used to setup the properties of the water.
         /*!
@@ -161,6 +219,7 @@ namespace sf
         Fluid liquid;
         std::vector<VelocityField*> currents;
         OpenGLOcean* glOcean;
+        SpectralWaves* cpuWaves;
         OceanCurrentsUBO glOceanCurrentsUBOData;
         Scalar depth;
         Scalar waterType;
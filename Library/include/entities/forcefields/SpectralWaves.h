@@ -0,0 +1,114 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SpectralWaves.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_SpectralWaves__
+#define __Stonefish_SpectralWaves__
+
+#include <complex>
+#include <vector>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A class implementing the spectral ocean wave model on the CPU.
+    /*!
+     The class generates the same wave spectrum as the OpenGL ocean and propagates it with an inverse FFT,
+     using the simulation time. It is used to compute the wave height when graphics is not available.
+     Only the two largest wave grids are simulated, as in the wave height computation of the OpenGL ocean.
+     */
+    class SpectralWaves
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param state the state of the ocean (>0)
+         */
+        SpectralWaves(Scalar state);
+
+        //! A method updating the wave field, if enough time has passed since the last update.
+        /*!
+         \param t the simulation time [s]
+         */
+        void Update(Scalar t);
+
+        //! A method computing the wave field at a specified time.
+        /*!
+         \param t the simulation time [s]
+         */
+        void Simulate(Scalar t);
+
+        //! A method to get wave height at a specified coordinate.
+        /*!
+         \param x the x coordinate in world frame [m]
+         \param y the y coordinate in world frame [m]
+         \return wave height [m]
+         */
+        float ComputeWaveHeight(float x, float y) const;
+
+        //! A method to get wave height at multiple points.
+        /*!
+         \param xyz an array of point coordinates in world frame (x,y,z interleaved) [m]
+         \param heights an array of wave heights [m]
+         \param count the number of points
+         */
+        void ComputeWaveHeight(const float* xyz, float* heights, size_t count) const;
+
+        //! A method to set the minimum period between updates of the wave field.
+        /*!
+         \param period the update period [s]
+         */
+        void setUpdatePeriod(Scalar period);
+
+        //! A method returning the time of the last update of the wave field.
+        Scalar getTime() const;
+
+    private:
+        void GenerateWavesSpectrum();
+        void GetSpectrumSample(int i, int j, float lengthScale, float kMin, long* seed, std::complex<float>& result);
+        float spectrum(float kx, float ky);
+        float omega(float k);
+        void FFT(std::complex<float>* data);
+        float ComputeInterpolatedWaveData(float x, float y, bool imaginary) const;
+
+        int passes;
+        int fftSize;
+        float gridSizes[2];
+        float wind;
+        float omegaSea;
+        float A;
+        float km;
+        float cm;
+        bool propagate;
+
+        std::vector<std::complex<float>> h0[2]; //Initial spectrum of the two wave grids
+        std::vector<std::complex<float>> waves; //Height field (real -> first grid, imaginary -> second grid)
+        std::vector<std::complex<float>> twiddle;
+        std::vector<int> reversed;
+        Scalar time;
+        Scalar updatePeriod;
+    };
+}
+
+#endif
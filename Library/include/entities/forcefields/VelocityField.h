@@ -51,6 +51,14 @@ namespace sf
          */
         virtual Vector3 GetVelocityAtPoint(const Vector3& p) const = 0;
         
+        //! A method adding the velocity of the field at multiple points to the output array.
+        /*!
+         \param xyz an array of point coordinates (x,y,z interleaved) [m]
+         \param out an array of velocities (x,y,z interleaved) to which the field velocity is added [m/s]
+         \param count the number of points
+         */
+        virtual void AddVelocityAtPoints(const GLfloat* xyz, GLfloat* out, size_t count) const;
+        
         //! A method implementing the rendering of the velocity field.
         virtual std::vector<Renderable> Render(VelocityFieldUBO& ubo) = 0;
 
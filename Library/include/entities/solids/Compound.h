@@ -39,6 +39,20 @@ namespace sf
         bool alwaysVisible;
     } CompoundPart;
     
+    //! A structure holding the hydrodynamic forces computed for one part of the compound body.
+    struct CompoundPartHydrodynamics
+    {
+        Vector3 Fb;
+        Vector3 Tb;
+        Vector3 Fdq;
+        Vector3 Tdq;
+        Vector3 Fdf;
+        Vector3 Tdf;
+        Scalar Swet;
+        Scalar Vsub;
+        Renderable submerged;
+    };
+    
     //! A class representing a rigid body built of multiple other rigid bodies.
     class Compound : public SolidEntity
     {
@@ -119,6 +133,9 @@ namespace sf
         //! A method that builds a graphical object for the body.
         void BuildGraphicalObject();
         
+        //! A method that builds the meshes used in the hydrodynamics computation of all parts.
+        void BuildHydrodynamicsMesh();
+        
         //! A method that returns elements that have to be rendered for the body.
         std::vector<Renderable> Render();
 
@@ -128,9 +145,13 @@ namespace sf
     private:
         std::vector<CompoundPart> parts; //Parts of the compound solid
         std::vector<size_t> collisionPartId;
+        std::vector<CompoundPartHydrodynamics> partHydro; //Results of the parallel computation of hydrodynamics
         bool displayInternals;
         
         void RecalculatePhysicalProperties();
+        BodyFluidPosition CheckPartFluidPosition(size_t partId, const Transform& T_C_part, Ocean* ocn);
+        void ComputePartHydrodynamics(size_t partId, BodyFluidPosition bf, const HydrodynamicsSettings& settings, Ocean* ocn,
+                                      const Vector3& g, const Vector3& v, const Vector3& omega);
     };
 
 }
@@ -27,6 +27,7 @@
 #define __Stonefish_Polyhedron__
 
 #include "entities/SolidEntity.h"
+#include "utils/CollisionGeometry.h"
 
 namespace sf
 {
@@ -81,8 +82,16 @@ namespace sf
         //! A method used to build the graphical representation of the body.
         void BuildGraphicalObject();
         
+        //! A method used to define how the collision geometry is generated (has to be called before adding the body to the simulation).
+        /*!
+         \param settings the collision geometry settings
+         */
+        void setCollisionGeometry(const CollisionGeometrySettings& settings);
+        
     private:
         Mesh *graMesh; //Mesh used for rendering
+        CollisionGeometrySettings colSettings;
+        std::string colCacheKey;
     };
 }
 
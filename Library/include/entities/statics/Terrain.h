@@ -28,6 +28,7 @@
 
 #include "BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
 #include "entities/StaticEntity.h"
+#include "core/RayQuery.h"
 
 namespace sf
 {
@@ -65,6 +66,13 @@ namespace sf
          */
         void getAABB(Vector3 &min, Vector3 &max);
         
+        //! A method testing a batch of rays against the terrain only, skipping the broadphase.
+        /*!
+         \param rays a batch of rays
+         \param hits a structure to store the results (resized to the size of the batch)
+         */
+        void RayTest(const RayBatch& rays, RayHits& hits) const;
+        
         //! A method returning the type of static entity.
         StaticEntityType getStaticType();
         
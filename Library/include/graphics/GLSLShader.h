@@ -27,6 +27,8 @@
 #define __Stonefish_GLSLShader__
 
 #include <utility>
+#include <map>
+#include <cstdint>
 #include "graphics/OpenGLDataStructs.h"
 
 namespace sf
@@ -62,6 +64,15 @@ namespace sf
         {};
     };
 
+    //! A structure holding shader program creation statistics.
+    struct GLSLProgramStats
+    {
+        unsigned int compiledPrograms; //!< Number of programs compiled and linked from source
+        unsigned int cachedPrograms; //!< Number of programs loaded from the program binary cache
+        double compileTime; //!< Time spent loading, compiling and linking shaders [s]
+        double cacheTime; //!< Time spent loading program binaries [s]
+    };
+
     //! A class representing a single GLSL shader.
     class GLSLShader
     {
@@ -268,6 +279,18 @@ namespace sf
         //! A static method to enable verbose shader compilation.
         static void Verbose();
         
+        //! A static method to enable the on-disk cache of linked program binaries.
+        /*!
+         Programs built from source files are stored in the binary form returned by the driver.
+         The cache key includes the resolved sources, their headers and the driver identification,
+         so that programs are recompiled whenever any of them changes.
+         \param directory path to the cache directory (empty string disables the cache)
+         */
+        static void EnableProgramCache(const std::string& directory);
+        
+        //! A static method returning the shader program creation statistics.
+        static GLSLProgramStats getProgramStats();
+        
         //! A method that compiles a given shader from source.
         /*!
          \param shaderType a type of the shader
@@ -279,6 +302,7 @@ namespace sf
         static GLuint LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint* shaderCompiled);
         
     private:
+        void Build(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled);
         bool GetAttribute(std::string name, ParameterType type, GLint& index);
         bool GetUniform(std::string name, ParameterType type, GLint& location);
         
@@ -289,7 +313,15 @@ namespace sf
         
         static GLuint saqVertexShader;
         static bool verbose;
+        static std::string programCacheDir;
+        static bool programBinarySupported;
+        static std::map<GLuint, uint64_t> shaderHashes;
+        static GLSLProgramStats stats;
+        static bool LoadShaderSource(const std::string& filename, const std::string& header, std::string& source);
+        static GLuint CompileShader(GLenum shaderType, const std::string& source, GLint* shaderCompiled);
         static GLuint CreateProgram(const std::vector<GLuint>& compiledShaders, unsigned int doNotDeleteNFirstShaders = 0);
+        static GLuint LoadProgramBinary(const std::string& filename);
+        static void SaveProgramBinary(GLuint program, const std::string& filename);
     };
 }
 
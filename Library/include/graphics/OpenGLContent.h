@@ -492,6 +492,24 @@ namespace sf
          */
         static void Refine(Mesh* mesh, GLfloat sizeThreshold);
         
+        //! A method to merge vertices which are closer than a specified distance.
+        /*!
+         Vertex attributes of the first vertex of each group are kept. Faces which become degenerate are removed.
+         \param mesh a pointer to a mesh structure
+         \param tolerance the maximum distance between merged vertices [m]
+         */
+        static void WeldVertices(Mesh* mesh, GLfloat tolerance);
+        
+        //! A method to reduce the number of faces of a mesh, using quadric error edge collapses.
+        /*!
+         Only vertex positions are considered, which makes the method suitable for physics meshes.
+         The mesh should be welded first, to make the connectivity of the surface explicit.
+         \param mesh a pointer to a mesh structure
+         \param targetFaceCount the number of faces at which the decimation stops
+         \param maxError the maximum distance of the collapsed vertices to the planes of the original faces [m] (0 for no limit)
+         */
+        static void Decimate(Mesh* mesh, size_t targetFaceCount, GLfloat maxError = 0.f);
+        
         //! A method to compute the axis-aligned bounding box of a mesh.
         /*!
          \param mesh a pointer to a mesh structure
@@ -349,6 +349,14 @@ namespace sf
         }
     };
     
+    //! A structure holding the pose of a view or a light, set by the simulation and published together with the drawing queue.
+    struct ViewPose
+    {
+        glm::vec3 origin; //Eye position (centre of the orbit for the trackball, position for lights)
+        glm::vec3 dir; //Looking direction (direction for spot lights)
+        glm::vec3 up; //Up direction
+    };
+    
     //! A structure containing data of a view frustum.
     struct ViewFrustum
     {
@@ -105,8 +105,14 @@ namespace sf
          */
         void SetupCamera(glm::vec3 eye, glm::vec3 dir, glm::vec3 up);
         
+        //! A method returning the pose set by the simulation.
+        ViewPose getPendingPose() const;
+        
         //! A method that updates camera world transform.
-        void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        void UpdateTransform(const ViewPose& pose);
 
         //! A method that flags the camera as needing update.
         void Update();
@@ -92,8 +92,14 @@ namespace sf
          */
         void UpdatePosition(glm::vec3 p);
         
+        //! A method returning the pose set by the simulation, published together with the drawing queue.
+        virtual ViewPose getPendingPose() const;
+        
         //! A method that updates light transformation.
-        virtual void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        virtual void UpdateTransform(const ViewPose& pose);
         
         //! A method to switch on the light.
         void SwitchOn();
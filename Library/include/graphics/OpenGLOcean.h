@@ -173,6 +173,14 @@ namespace sf
          */
         virtual GLfloat ComputeWaveHeight(GLfloat x, GLfloat y);
 
+        //! A method to get wave height at multiple points.
+        /*!
+         \param xyz an array of point coordinates in world frame (x,y,z interleaved) [m]
+         \param heights an array of wave heights [m]
+         \param count the number of points
+         */
+        virtual void ComputeWaveHeight(const GLfloat* xyz, GLfloat* heights, size_t count);
+
         //! A method returning the id of the wave texture.
         GLuint getWaveTexture();
 
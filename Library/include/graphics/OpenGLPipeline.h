@@ -27,9 +27,11 @@
 #define __Stonefish_OpenGLPipeline__
 
 #include <SDL2/SDL_thread.h>
+#include <atomic>
 #include <deque>
 #include "StonefishCommon.h"
 #include "graphics/OpenGLDataStructs.h"
+#include "graphics/OpenGLOcean.h"
 
 namespace sf
 {
@@ -59,6 +61,7 @@ namespace sf
         
         //! A method to add renderable objects to the rendering queue.
         /*!
+         The objects are copied into a preallocated snapshot, reusing the memory of the objects from earlier frames.
          \param r a renderable object
          */
         void AddToDrawingQueue(const Renderable& r);
@@ -89,12 +92,18 @@ namespace sf
 
         //! A method that clears the drawing queue for selected objects.
         void PurgeSelectedDrawingQueue();
-
-        //! A method that informs if the drawing queue is empty.
-        bool isDrawingQueueEmpty();
         
-        //! A method to get mutex of the drawing queue for thread safeness.
-        SDL_mutex* getDrawingQueueMutex();
+        //! A method that makes the drawing queue available to the renderer and starts a new one.
+        /*!
+         The snapshots are triple buffered, so neither thread waits for the other.
+         The poses of views and lights and the ocean currents data are published together with the drawing queue.
+         A snapshot not yet taken by the renderer is replaced by the newer one.
+         \param sim a pointer to the simulation manager
+         */
+        void PublishDrawingQueue(SimulationManager* sim);
+        
+        //! A method informing if the last published drawing queue was not yet taken by the renderer.
+        bool isDrawingQueuePending() const;
         
         //! A method returning a copy of the render settings.
         RenderSettings getRenderSettings() const;
@@ -109,16 +118,34 @@ namespace sf
         OpenGLContent* getContent();
         
     private:
+        //! A structure holding a snapshot of the drawing queue.
+        struct RenderSnapshot
+        {
+            std::vector<Renderable> objects;
+            std::vector<Renderable> selected;
+            size_t nObjects;
+            size_t nSelected;
+            std::vector<ViewPose> views;
+            std::vector<ViewPose> lights;
+            OceanCurrentsUBO currents;
+            bool hasCurrents;
+            
+            RenderSnapshot() : nObjects(0), nSelected(0), hasCurrents(false) {}
+        };
+        
+        static void AddToSnapshot(std::vector<Renderable>& queue, size_t& n, const Renderable& r);
         void PerformDrawingQueueCopy(SimulationManager* sim);
         void DrawHelpers();
         
+        static constexpr unsigned int newSnapshotFlag = 4;
+        static constexpr unsigned int snapshotIndexMask = 3;
+        
         RenderSettings rSettings;
         HelperSettings hSettings;
-        std::vector<Renderable> drawingQueue;
-        std::vector<Renderable> drawingQueueCopy;
-        std::vector<Renderable> selectedDrawingQueue;
-        std::vector<Renderable> selectedDrawingQueueCopy;
-        SDL_mutex* drawingQueueMutex;
+        RenderSnapshot snapshots[3];
+        unsigned int backSnapshot; //Written by the simulation
+        unsigned int frontSnapshot; //Read by the renderer
+        std::atomic<unsigned int> latestSnapshot; //Index of the last published snapshot (+ flag if not taken yet)
         std::deque<unsigned int> viewsQueue;
         GLuint screenFBO;
         GLuint screenTex;
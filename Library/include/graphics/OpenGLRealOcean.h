@@ -94,6 +94,14 @@ namespace sf
          */
         GLfloat ComputeWaveHeight(GLfloat x, GLfloat y);
 
+        //! A method to get wave height at multiple points.
+        /*!
+         \param xyz an array of point coordinates in world frame (x,y,z interleaved) [m]
+         \param heights an array of wave heights [m]
+         \param count the number of points
+         */
+        void ComputeWaveHeight(const GLfloat* xyz, GLfloat* heights, size_t count);
+
         //! A method do enable wireframe rendering.
         /*!
          \param enabled a flag to indicating if wireframe should be enabled
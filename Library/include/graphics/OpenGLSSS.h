@@ -71,7 +71,10 @@ namespace sf
         void DrawLDR(GLuint destinationFBO, bool updated);
         
         //! A method that updates sonar world transform.
-        void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        void UpdateTransform(const ViewPose& pose);
 
         //! A method to set the noise properties of the sonar.
         /*!
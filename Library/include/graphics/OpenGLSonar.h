@@ -89,8 +89,14 @@ namespace sf
          */
         void SetupSonar(glm::vec3 eye, glm::vec3 dir, glm::vec3 up);
         
+        //! A method returning the pose set by the simulation.
+        ViewPose getPendingPose() const;
+        
         //! A method that updates sonar world transform.
-        virtual void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        virtual void UpdateTransform(const ViewPose& pose);
 
         //! A method that flags the sonar as needing update.
         void Update();
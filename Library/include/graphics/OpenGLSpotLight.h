@@ -94,8 +94,14 @@ namespace sf
          */
         void UpdateDirection(glm::vec3 d);
         
+        //! A method returning the pose set by the simulation.
+        ViewPose getPendingPose() const;
+        
         //! A method that updates light transformation.
-        void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        void UpdateTransform(const ViewPose& pose);
         
         //! A method returning the type of the light.
         LightType getType() const;
@@ -76,8 +76,14 @@ namespace sf
         //! A method saving the new centre for update.
         void UpdateCenterPos();
 
+        //! A method returning the pose set by the simulation (centre of the orbit).
+        ViewPose getPendingPose() const;
+        
         //! A method used to update the trasformation of the trackball.
-        void UpdateTransform();
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        void UpdateTransform(const ViewPose& pose);
         
         //! A method servicing the mouse down event.
         /*!
@@ -129,6 +135,7 @@ namespace sf
         
     private:
         GLfloat calculateZ(GLfloat x, GLfloat y);
+        void UpdateViewMatrix();
         
         MovingEntity* holdingEntity;
         
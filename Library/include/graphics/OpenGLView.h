@@ -66,8 +66,14 @@ namespace sf
          */
         virtual void DrawLDR(GLuint destinationFBO, bool updated) = 0;
 
+        //! A method returning the pose set by the simulation, published together with the drawing queue.
+        virtual ViewPose getPendingPose() const = 0;
+        
         //! A method that updates view world transform.
-        virtual void UpdateTransform() = 0;
+        /*!
+         \param pose the pose published together with the drawing queue
+         */
+        virtual void UpdateTransform(const ViewPose& pose) = 0;
 
         //! A method that returns eye position.
         virtual glm::vec3 GetEyePosition() const = 0;
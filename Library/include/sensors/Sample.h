@@ -50,6 +50,22 @@ namespace sf
          */
         Sample(const Sample& other, uint64_t index = 0);
         
+        //! A constructor building a sample from stored data.
+        /*!
+         \param timestamp the time of the measurement [s]
+         \param nDimensions the number of dimensions of the measurement
+         \param values a pointer to the data
+         \param index a number specifying the id of the sample
+         */
+        Sample(Scalar timestamp, unsigned short nDimensions, const Scalar* values, uint64_t index = 0);
+        
+        //! An assignment operator.
+        /*!
+         \param other a reference to a sample object
+         \return a reference to this sample
+         */
+        Sample& operator=(const Sample& other);
+        
         //! A destructor.
         ~Sample();
         
@@ -76,9 +92,14 @@ namespace sf
         uint64_t getId() const;
         
     private:
+        void Allocate(unsigned short nDimensions);
+        
+        static constexpr unsigned short localCapacity = 16;
+        
         Scalar timestamp;
         unsigned short nDim;
         Scalar* data;
+        Scalar localData[localCapacity]; //Samples with few dimensions do not allocate memory
         uint64_t id;
     };
 }
@@ -26,7 +26,6 @@
 #ifndef __Stonefish_ScalarSensor__
 #define __Stonefish_ScalarSensor__
 
-#include <deque>
 #include "sensors/Sensor.h"
 
 namespace sf
@@ -83,6 +82,56 @@ namespace sf
     
     class Sample;
     
+    //! A structure providing a read-only view of the history of sensor measurements, without copying the data.
+    /*!
+     The history is stored in a ring buffer, with the values of all channels of a sample placed next to each other.
+     The view is only valid until the next update of the sensor, so it should be used inside LockHistory()/UnlockHistory().
+     */
+    struct HistoryView
+    {
+        const Scalar* values;
+        const Scalar* timestamps;
+        size_t capacity;
+        size_t first;
+        size_t count;
+        unsigned short nChannels;
+        
+        //! A method returning the number of samples in the history.
+        size_t size() const { return count; }
+        
+        //! A method returning a pointer to the values of all channels of a sample.
+        /*!
+         \param index the index of the sample (0 -> oldest)
+         \return a pointer to the sample values
+         */
+        const Scalar* getData(size_t index) const
+        {
+            size_t i = first + index;
+            if(i >= capacity) i -= capacity;
+            return values + i * nChannels;
+        }
+        
+        //! A method returning the value of a single channel of a sample.
+        /*!
+         \param index the index of the sample (0 -> oldest)
+         \param channel the index of the channel
+         \return value of the measurement
+         */
+        Scalar getValue(size_t index, unsigned short channel) const { return channel < nChannels ? getData(index)[channel] : Scalar(0); }
+        
+        //! A method returning the timestamp of a sample.
+        /*!
+         \param index the index of the sample (0 -> oldest)
+         \return the timestamp of the sample [s]
+         */
+        Scalar getTimestamp(size_t index) const
+        {
+            size_t i = first + index;
+            if(i >= capacity) i -= capacity;
+            return timestamps[i];
+        }
+    };
+    
     //! An abstract class representing a scalar sensor.
     class ScalarSensor : public Sensor
     {
@@ -113,6 +162,9 @@ namespace sf
         //! A method clearing the history of measurements.
         void ClearHistory();
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to save the measurements to a text file.
         /*!
          \param path a path to the output file
@@ -138,6 +190,15 @@ namespace sf
         //! A method returing a pointer to a copy of the history of sensor measurements.
         const std::vector<Sample>* getHistory();
         
+        //! A method returning a view of the history of sensor measurements, without copying the data.
+        HistoryView getHistoryView() const;
+        
+        //! A method locking the history, to prevent it from being updated while in use.
+        void LockHistory();
+        
+        //! A method unlocking the history.
+        void UnlockHistory();
+        
         //! A method returning the value of the measurement.
         /*!
          \param index the index of the history
@@ -168,12 +229,15 @@ namespace sf
         
     protected:
         void AddSampleToHistory(const Sample& s);
-        std::deque<Sample*> history;
         std::vector<SensorChannel> channels;
         uint64_t sampleCount;
         
     private:
         int historyLen;
+        std::vector<Scalar> historyValues; //Ring buffer of channel values (channels x capacity)
+        std::vector<Scalar> historyTimestamps; //Ring buffer of timestamps (capacity)
+        size_t historyFirst;
+        size_t historyCount;
     };
 }
     
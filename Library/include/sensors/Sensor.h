@@ -36,6 +36,8 @@ namespace sf
     enum class SensorType {JOINT, LINK, VISION, OTHER};
     
     struct Renderable;
+    class StateBuffer;
+    class StateReader;
     
     //! An abstract class representing a sensor.
     class Sensor
@@ -107,13 +109,32 @@ namespace sf
 
         //! A method returning the sensor measurement frame.
         virtual Transform getSensorFrame() const = 0;
+
+        //! A method returning the sensors which have to be updated before this one.
+        virtual std::vector<Sensor*> getDependencies() const;
+
+        //! A method to seed the noise generator of the sensor.
+        /*!
+         \param seed the seed value
+         */
+        void setRandomSeed(unsigned int seed);
+        
+        //! A method saving the dynamic state of the sensor.
+        /*!
+         \param state a buffer to which the state is appended
+         */
+        virtual void SaveState(StateBuffer& state) const;
+        
+        //! A method restoring the dynamic state of the sensor.
+        /*!
+         \param state a reader of the buffer written by the same sensor
+         */
+        virtual void RestoreState(StateReader& state);
         
     protected:
         Scalar freq;
         SDL_mutex* updateMutex;
-        
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        std::mt19937 randomGenerator;
         
     private:
         std::string name;
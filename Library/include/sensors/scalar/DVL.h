@@ -27,9 +27,12 @@
 #define __Stonefish_DVL__
 
 #include "sensors/scalar/LinkSensor.h"
+#include "core/RayQuery.h"
 
 namespace sf
 {
+    class Terrain;
+    
     //! A class representing a Dopple velocity log (DVL) sensor with four beams.
     class DVL : public LinkSensor
     {
@@ -76,6 +79,13 @@ namespace sf
          */
         void setNoise(Scalar velPercent, Scalar velStdDev, Scalar altitudeStdDev, Scalar waterVelPercent, Scalar waterVelStdDev);
         
+        //! A method used to set a terrain as the only bottom seen by the sensor.
+        /*!
+         The beams are then tested directly against the terrain heightfield, skipping all other objects.
+         \param terrain a pointer to the terrain (nullptr to test the beams against the whole world)
+         */
+        void setSeabed(Terrain* terrain);
+        
         //! A method that returns the measurement ranges of the DVL.
         /*!
          \param velocityMax the output variable to store the maximum measured linear velocity [m s^-1]
@@ -94,10 +104,15 @@ namespace sf
         ScalarSensorType getScalarSensorType() const;
         
     private:
+        void CastBeams();
+        
         Scalar beamAngle;
         bool beamPosZ;
         Scalar range[4];
         Vector3 waterLayer;
+        RayBatch rays;
+        RayHits hits;
+        Terrain* seabed;
         Scalar addNoiseStdDev[2]; //Additive noise
         Scalar mulNoiseFactor[2]; //Noise dependent on distance
     };
@@ -61,6 +61,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to set the range of the sensor.
         /*!
          \param forceMax a vector representing the maximum measured forces [N]
@@ -48,6 +48,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
 
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+
         //! A method that resets the sensor.
         void Reset();
         
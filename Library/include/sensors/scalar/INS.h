@@ -51,6 +51,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
 
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+
         //! A method that resets the sensor.
         void Reset();
 
@@ -95,6 +98,9 @@ namespace sf
         //! A method rendering the sensor representation.
         std::vector<Renderable> Render();
 
+        //! A method returning the sensors which have to be updated before the INS.
+        std::vector<Sensor*> getDependencies() const;
+
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType() const;
 
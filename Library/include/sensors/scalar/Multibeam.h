@@ -27,6 +27,7 @@
 #define __Stonefish_Multibeam__
 
 #include "sensors/scalar/LinkSensor.h"
+#include "core/RayQuery.h"
 
 namespace sf
 {
@@ -77,6 +78,8 @@ namespace sf
         unsigned int angSteps;
         std::vector<Scalar> angles;
         std::vector<Scalar> distances;
+        RayBatch rays;
+        RayHits hits;
     };
 }
 
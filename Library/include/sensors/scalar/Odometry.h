@@ -48,6 +48,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to set the noise characteristics of the sensor.
         /*!
          \param positionStdDev standard deviation of the position measurement noise
@@ -27,6 +27,7 @@
 #define __Stonefish_Profiler__
 
 #include "sensors/scalar/LinkSensor.h"
+#include "core/RayQuery.h"
 
 namespace sf
 {
@@ -50,6 +51,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to set the range of the sensor.
         /*!
          \param rangeMin the minimum measured range [m]
@@ -75,6 +79,8 @@ namespace sf
         unsigned int currentAngStep;
         Scalar distance;
         bool clockwise;
+        RayBatch rays;
+        RayHits hits;
     };
 }
 
@@ -63,6 +63,9 @@ namespace sf
          */
         virtual void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method that resets the sensor.
         virtual void Reset();
         
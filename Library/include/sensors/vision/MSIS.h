@@ -64,6 +64,9 @@ namespace sf
          */
         void InternalUpdate(Scalar dt);
         
+        void SaveState(StateBuffer& state) const override;
+        void RestoreState(StateReader& state) override;
+        
         //! A method used to setup the OpenGL sonar transformation.
         /*!
          \param eye the position of the sonar eye [m]
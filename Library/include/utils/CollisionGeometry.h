@@ -0,0 +1,89 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  CollisionGeometry.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_CollisionGeometry__
+#define __Stonefish_CollisionGeometry__
+
+#include "StonefishCommon.h"
+#include "graphics/OpenGLDataStructs.h"
+
+namespace sf
+{
+    //! An enum defining the type of collision geometry generated for a mesh.
+    enum class CollisionGeometryType {CONVEX_HULL, CONVEX_DECOMPOSITION};
+    
+    //! A structure defining how the collision geometry is generated for a mesh.
+    struct CollisionGeometrySettings
+    {
+        CollisionGeometryType type;
+        unsigned int maxHullVertices; //0 -> no limit
+        unsigned int maxHulls;
+        Scalar maxConcavity;
+        
+        CollisionGeometrySettings() : type(CollisionGeometryType::CONVEX_HULL), maxHullVertices(0), maxHulls(16), maxConcavity(Scalar(0.01))
+        {
+        }
+    };
+    
+    //! A function computing the convex hull of a set of points.
+    /*!
+     If the hull has more vertices than allowed, only the vertices supporting the hull in evenly distributed directions are kept.
+     \param points a set of points
+     \param maxVertices the maximum number of hull vertices (0 for no limit)
+     \return the vertices of the hull
+     */
+    std::vector<Vector3> ComputeConvexHull(const std::vector<Vector3>& points, unsigned int maxVertices = 0);
+    
+    //! A function computing an approximate convex decomposition of a mesh.
+    /*!
+     The mesh is recursively split with axis-aligned planes, minimising the total volume of the hulls of the parts,
+     until the concavity of all parts is below the limit or the maximum number of parts is reached.
+     \param mesh a pointer to the mesh structure
+     \param maxHulls the maximum number of convex parts
+     \param maxConcavity the maximum distance between a vertex of a part and the surface of its hull [m]
+     \param maxHullVertices the maximum number of vertices of each hull (0 for no limit)
+     \return the vertices of the hulls of all parts
+     */
+    std::vector<std::vector<Vector3>> ComputeConvexDecomposition(const Mesh* mesh, unsigned int maxHulls, Scalar maxConcavity, unsigned int maxHullVertices = 0);
+    
+    //! A function generating the convex hulls used for collision of a mesh.
+    /*!
+     \param mesh a pointer to the mesh structure
+     \param settings the collision geometry settings
+     \param cacheKey a key identifying the mesh in the on-disk cache (empty to skip the cache)
+     \return the vertices of the hulls
+     */
+    std::vector<std::vector<Vector3>> BuildCollisionHulls(const Mesh* mesh, const CollisionGeometrySettings& settings, const std::string& cacheKey = "");
+    
+    //! A function creating a collision shape from a set of convex hulls.
+    /*!
+     \param hulls the vertices of the hulls
+     \return a pointer to a convex hull shape, or a compound shape if more than one hull was passed
+     */
+    btCollisionShape* CreateConvexCollisionShape(const std::vector<std::vector<Vector3>>& hulls);
+}
+
+#endif
@@ -41,6 +41,14 @@ namespace sf
         Matrix3 Irot;
     };
     
+    //! A structure holding a mesh prepared for the physics computations, together with its properties.
+    struct ProcessedGeometry
+    {
+        Mesh* mesh; //Shared between all users, read-only
+        MeshProperties properties;
+        Vector3 ellipsoidAxes; //Half-extents of the mesh in the frame of the principal axes of inertia
+    };
+    
     //! A function to load geometry from a file.
     /*!
      \param path a path to the file
@@ -49,6 +57,78 @@ namespace sf
      */
     Mesh* LoadGeometryFromFile(const std::string& path, GLfloat scale);
     
+    //! A function to enable the in-memory cache of loaded geometry files.
+    /*!
+     When enabled, each file is parsed only once and subsequent loads return copies of the cached mesh
+     (useful when many simulation worlds are built from the same data).
+     \param enabled a flag indicating if the cache should be used
+     */
+    void EnableGeometryCache(bool enabled);
+    
+    //! A function to release all meshes stored in the geometry cache.
+    void ClearGeometryCache();
+    
+    //! A function to enable the persistent on-disk cache of processed geometry.
+    /*!
+     Processed geometry is stored in a binary format, under a name computed from the file path, the file modification time
+     and the processing parameters. The data is laid out as a header followed by raw vertex and face arrays.
+     \param directory a path to the directory used to store the cache files (empty to disable the cache)
+     */
+    void EnableMeshCache(const std::string& directory);
+    
+    //! A function to create a key identifying a geometry file and its processing parameters.
+    /*!
+     \param path a path to the file
+     \param params a text representation of the processing parameters
+     \return a key including the size and modification time of the file
+     */
+    std::string MakeGeometryCacheKey(const std::string& path, const std::string& params);
+    
+    //! A function returning the path of the on-disk cache file corresponding to a key.
+    /*!
+     \param key a key identifying the cached data
+     \param extension the extension of the cache file
+     \return a path to the cache file or an empty string if the cache is disabled
+     */
+    std::string GetMeshCacheFilename(const std::string& key, const std::string& extension);
+    
+    //! A function to load geometry and prepare it for the physics computations.
+    /*!
+     The mesh is loaded, repaired, refined and its physical properties are computed. The result is shared between
+     all users requesting the same data and has to be released with ReleaseMesh().
+     \param path a path to the file
+     \param scale a scale to apply to the data
+     \param refineThreshold the relative face size above which faces are subdivided (0 to disable refinement)
+     \param thickness a value of the wall thickness [m]
+     \param density the density of the material the mesh is made of [kg/m3]
+     \return a pointer to the processed geometry
+     */
+    const ProcessedGeometry* LoadProcessedGeometry(const std::string& path, GLfloat scale, GLfloat refineThreshold, Scalar thickness, Scalar density);
+    
+    //! A function to release a mesh.
+    /*!
+     Meshes shared through LoadProcessedGeometry() are deleted when the last user releases them, others are deleted immediately.
+     \param mesh a pointer to the mesh structure
+     */
+    void ReleaseMesh(Mesh* mesh);
+    
+    //! A function to keep the processed geometry in memory after its last user releases it.
+    /*!
+     Useful when the same scenario is built repeatedly, e.g., on restart. Disabling the retention frees the unused geometry.
+     \param enabled a flag indicating if unused processed geometry should be kept
+     */
+    void RetainProcessedGeometry(bool enabled);
+    
+    //! A function to free the processed geometry that is kept in memory but not used by any body.
+    void ReleaseUnusedGeometry();
+    
+    //! A function to create a deep copy of a mesh.
+    /*!
+     \param mesh a pointer to the mesh structure
+     \return a pointer to an allocated copy of the mesh
+     */
+    Mesh* CopyMesh(const Mesh* mesh);
+    
     //! A function to load geometry from a STL file.
     /*!
      \param path a path to the file
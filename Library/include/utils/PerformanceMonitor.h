@@ -28,11 +28,21 @@
 
 #include <SDL2/SDL_mutex.h>
 #include <chrono>
-#include <deque>
 #include <vector>
+#include <string>
+#include <map>
 
 namespace sf
 {
+    //! A structure holding a fixed-length history of time measurements, with a running sum.
+    struct TimeHistory
+    {
+        std::vector<double> data;
+        size_t head;
+        size_t count;
+        double sum;
+    };
+    
     class PerformanceMonitor
     {
     public:
@@ -45,6 +55,9 @@ namespace sf
         void PhysicsFinished();
         void HydrodynamicsStarted();
         void HydrodynamicsFinished();
+        void SensorsStarted();
+        void SensorsFinished();
+        void SensorsUpdated(const std::vector<std::string>& names, const std::vector<double>& times);
 
         // In seconds.
         double getSimulationTime();
@@ -58,16 +71,21 @@ namespace sf
         double getHydrodynamicsTimeAverage();
         template<typename T> std::vector<T> getHydrodynamicsTimeHistory(size_t len) { return getHistory<T>(hydroTime, len); };
 
+        double getSensorsTime();
+        double getSensorsTimeAverage();
+        template<typename T> std::vector<T> getSensorsTimeHistory(size_t len) { return getHistory<T>(sensTime, len); };
+        std::vector<std::pair<std::string, double>> getSensorTimeAverages();
+
     private:
-        void Update(const std::chrono::high_resolution_clock::time_point& start, std::deque<double>& times, double& average);
-        template<typename T> std::vector<T> getHistory(std::deque<double>& data, size_t len)
+        void Update(const std::chrono::high_resolution_clock::time_point& start, TimeHistory& times, double& average);
+        void Reset(TimeHistory& times);
+        template<typename T> std::vector<T> getHistory(TimeHistory& times, size_t len)
         { 
-            std::vector<T> dataOut; 
-            dataOut.resize(data.size() < len ? data.size() : len);
             SDL_LockMutex(updateMtx);
-            size_t offset = data.size() - dataOut.size();
-            for(size_t i=data.size()-dataOut.size(); i<data.size(); ++i) 
-                dataOut[i-offset] = (T)(data[i]);
+            std::vector<T> dataOut(times.count < len ? times.count : len);
+            size_t n = times.data.size();
+            for(size_t i=0; i<dataOut.size(); ++i) 
+                dataOut[i] = (T)(times.data[(times.head + n - dataOut.size() + i) % n]);
             SDL_UnlockMutex(updateMtx);   
             return dataOut;
         };
@@ -76,12 +94,16 @@ namespace sf
         std::chrono::high_resolution_clock::time_point simStart;
         std::chrono::high_resolution_clock::time_point phyStart;
         std::chrono::high_resolution_clock::time_point hydroStart;
+        std::chrono::high_resolution_clock::time_point sensStart;
         double simTime;
         bool simFinished;
-        std::deque<double> phyTime;
-        std::deque<double> hydroTime;
+        TimeHistory phyTime;
+        TimeHistory hydroTime;
+        TimeHistory sensTime;
         double phyTimeAvg;
         double hydroTimeAvg;
+        double sensTimeAvg;
+        std::map<std::string, double> sensorTimeAvg;
         SDL_mutex* updateMtx;
     };
 }
@@ -27,6 +27,8 @@
 #define __Stonefish_RayTest__
 
 #include "BulletCollision/CollisionDispatch/btCollisionWorld.h"
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletSoftBody/btSoftMultiBodyDynamicsWorld.h"
 
 struct DetailedRayResultCallback : public btCollisionWorld::ClosestRayResultCallback
 {
@@ -48,4 +50,70 @@ struct DetailedRayResultCallback : public btCollisionWorld::ClosestRayResultCall
     int m_childShapeIndex;
 };
 
+//Broadphase callback testing the objects found by the traversal (same as the one used internally by Bullet)
+struct SingleRayCallback : public btBroadphaseRayCallback
+{
+    SingleRayCallback(const btVector3& rayFromWorld, const btVector3& rayToWorld, btCollisionWorld::RayResultCallback& resultCallback)
+        : m_resultCallback(resultCallback)
+    {
+        m_rayFromTrans.setIdentity();
+        m_rayFromTrans.setOrigin(rayFromWorld);
+        m_rayToTrans.setIdentity();
+        m_rayToTrans.setOrigin(rayToWorld);
+        
+        btVector3 rayDir = (rayToWorld - rayFromWorld).normalized();
+        m_rayDirectionInverse[0] = rayDir[0] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / rayDir[0];
+        m_rayDirectionInverse[1] = rayDir[1] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / rayDir[1];
+        m_rayDirectionInverse[2] = rayDir[2] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / rayDir[2];
+        m_signs[0] = m_rayDirectionInverse[0] < btScalar(0);
+        m_signs[1] = m_rayDirectionInverse[1] < btScalar(0);
+        m_signs[2] = m_rayDirectionInverse[2] < btScalar(0);
+        m_lambda_max = rayDir.dot(rayToWorld - rayFromWorld);
+    }
+    
+    virtual bool process(const btBroadphaseProxy* proxy)
+    {
+        if(m_resultCallback.m_closestHitFraction == btScalar(0))
+            return false;
+        
+        btCollisionObject* collisionObject = (btCollisionObject*)proxy->m_clientObject;
+        if(m_resultCallback.needsCollision(collisionObject->getBroadphaseHandle()))
+            btSoftMultiBodyDynamicsWorld::rayTestSingle(m_rayFromTrans, m_rayToTrans, collisionObject, 
+                                                        collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), m_resultCallback);
+        return true;
+    }
+    
+    btTransform m_rayFromTrans;
+    btTransform m_rayToTrans;
+    btCollisionWorld::RayResultCallback& m_resultCallback;
+};
+
+//Leaf callback of the broadphase tree traversal
+struct SingleRayLeafTester : btDbvt::ICollide
+{
+    SingleRayLeafTester(btBroadphaseRayCallback& rayCallback) : m_rayCallback(rayCallback)
+    {
+    }
+    
+    void Process(const btDbvtNode* leaf)
+    {
+        m_rayCallback.process((btDbvtProxy*)leaf->data);
+    }
+    
+    btBroadphaseRayCallback& m_rayCallback;
+};
+
+//Ray test traversing the broadphase tree with a stack provided by the caller, which makes it safe to run in parallel
+inline void DbvtRayTest(btDbvtBroadphase* broadphase, const btVector3& rayFromWorld, const btVector3& rayToWorld,
+                        btCollisionWorld::RayResultCallback& resultCallback, btAlignedObjectArray<const btDbvtNode*>& stack)
+{
+    SingleRayCallback rayCB(rayFromWorld, rayToWorld, resultCallback);
+    SingleRayLeafTester tester(rayCB);
+    btVector3 aabb(0, 0, 0);
+    
+    for(int i=0; i<2; ++i)
+        broadphase->m_sets[i].rayTestInternal(broadphase->m_sets[i].m_root, rayFromWorld, rayToWorld, 
+                                              rayCB.m_rayDirectionInverse, rayCB.m_signs, rayCB.m_lambda_max, aabb, aabb, stack, tester);
+}
+
 #endif
\ No newline at end of file
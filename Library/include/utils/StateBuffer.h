@@ -0,0 +1,173 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  StateBuffer.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_StateBuffer__
+#define __Stonefish_StateBuffer__
+
+#include <type_traits>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A class implementing a binary buffer used to store the dynamic state of simulation objects.
+    /*!
+     Values are stored as raw bytes, so the buffer is only valid within the running program.
+     The memory of the buffer is kept when it is cleared, to avoid allocations when the state is saved repeatedly.
+     */
+    class StateBuffer
+    {
+    public:
+        //! A constructor.
+        StateBuffer();
+        
+        //! A method removing all data from the buffer (the memory is kept).
+        void Clear();
+        
+        //! A method appending a value to the buffer.
+        /*!
+         \param value a value of a trivially copyable type
+         */
+        template<typename T> void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly!");
+            WriteBytes(&value, sizeof(T));
+        }
+        
+        //! A method appending an array of values to the buffer.
+        /*!
+         \param values an array of values of a trivially copyable type
+         */
+        template<typename T> void Write(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly!");
+            Write((uint64_t)values.size());
+            if(!values.empty())
+                WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+        
+        //! A method appending a transformation to the buffer.
+        /*!
+         \param value a transformation
+         */
+        void Write(const Transform& value);
+        
+        //! A method appending a string to the buffer.
+        /*!
+         \param value a string
+         */
+        void Write(const std::string& value);
+        
+        //! A method appending raw bytes to the buffer.
+        /*!
+         \param src a pointer to the data
+         \param size the number of bytes
+         */
+        void WriteBytes(const void* src, size_t size);
+        
+        //! A method returning the pointer to the data.
+        const char* getData() const;
+        
+        //! A method returning the size of the data [B].
+        size_t getSize() const;
+        
+    private:
+        std::vector<char> data;
+    };
+    
+    //! A class implementing sequential reading of a state buffer.
+    class StateReader
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param buffer a reference to the buffer that should be read
+         */
+        StateReader(const StateBuffer& buffer);
+        
+        //! A method reading a value from the buffer.
+        /*!
+         \param value a reference to a value of a trivially copyable type
+         */
+        template<typename T> void Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly!");
+            ReadBytes(&value, sizeof(T));
+        }
+        
+        //! A method reading an array of values from the buffer.
+        /*!
+         \param values a reference to an array of values of a trivially copyable type
+         */
+        template<typename T> void Read(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly!");
+            uint64_t n = 0;
+            Read(n);
+            if(n * sizeof(T) > Remaining())
+            {
+                valid = false;
+                return;
+            }
+            values.resize((size_t)n);
+            if(n > 0)
+                ReadBytes(values.data(), (size_t)n * sizeof(T));
+        }
+        
+        //! A method reading a transformation from the buffer.
+        /*!
+         \param value a reference to a transformation
+         */
+        void Read(Transform& value);
+        
+        //! A method reading a string from the buffer.
+        /*!
+         \param value a reference to a string
+         */
+        void Read(std::string& value);
+        
+        //! A method reading raw bytes from the buffer.
+        /*!
+         \param dst a pointer to the destination memory
+         \param size the number of bytes
+         */
+        void ReadBytes(void* dst, size_t size);
+        
+        //! A method informing if all reads were within the buffer.
+        bool isValid() const;
+        
+        //! A method informing if the whole buffer was read.
+        bool isAtEnd() const;
+        
+    private:
+        size_t Remaining() const;
+        
+        const StateBuffer& buffer;
+        size_t cursor;
+        bool valid;
+    };
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  TaskScheduler.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_TaskScheduler__
+#define __Stonefish_TaskScheduler__
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+namespace sf
+{
+    //! A static class implementing a pool of worker threads with work stealing.
+    /*!
+     Each worker owns a queue of tasks. A worker runs the newest task from its own queue and, when it is empty,
+     steals the oldest task from the other queues. Tasks submitted by threads that are not workers go to a shared queue.
+     A thread waiting for its tasks to finish runs the remaining tasks of the same loop or graph in the meantime, so parallel loops
+     and task graphs can be nested. It never runs unrelated tasks, because it can hold locks (e.g. of its simulation world).
+     The simulation manager bound to the submitting thread is bound to the thread running the task.
+     */
+    class TaskScheduler
+    {
+    public:
+        //! A static method to start the worker threads.
+        /*!
+         The scheduler is started automatically, with the default settings, when it is first used.
+         The settings cannot be changed while tasks are running.
+         \param numThreads the number of threads running the tasks, including the calling thread (0 -> half of the hardware threads)
+         \param pinThreads a flag to decide if the worker threads should be pinned to separate cores
+         */
+        static void Init(unsigned int numThreads = 0, bool pinThreads = false);
+        
+        //! A static method to stop the worker threads.
+        static void Shutdown();
+        
+        //! A static method running a function for each index in a range, in parallel.
+        /*!
+         The indices are distributed dynamically, in chunks of the specified size.
+         \param begin the first index
+         \param end the index after the last one
+         \param func the function to run for each index
+         \param grain the number of consecutive indices processed by a single task at a time
+         */
+        static void ParallelFor(size_t begin, size_t end, const std::function<void(size_t)>& func, size_t grain = 1);
+        
+        //! A static method returning the number of threads running the tasks, including the calling thread.
+        static unsigned int getNumOfThreads();
+        
+        //! A static method informing if the worker threads are pinned to cores.
+        static bool isPinningThreads();
+        
+        //! A static method to lock the settings of the scheduler against changes requested by the scenario files.
+        /*!
+         Used by applications which decide on the number of threads themselves.
+         \param enabled a flag indicating if the settings are locked
+         */
+        static void setLocked(bool enabled);
+        
+        //! A static method informing if the settings of the scheduler are locked against changes requested by the scenario files.
+        static bool isLocked();
+        
+    private:
+        TaskScheduler() = delete;
+        
+        static void Submit(const std::function<void()>& task, std::atomic<size_t>* pending);
+        static void Wait(std::atomic<size_t>* pending);
+        
+        friend class TaskGraph;
+    };
+    
+    //! A class implementing a graph of tasks with explicit dependencies.
+    /*!
+     A task is run after all of its dependencies are finished. Independent tasks are run in parallel by the task scheduler.
+     */
+    class TaskGraph
+    {
+    public:
+        //! A constructor.
+        TaskGraph();
+        
+        //! A method adding a task to the graph.
+        /*!
+         \param task the function to run
+         \param dependencies a list of ids of the previously added tasks that have to finish before this task is run
+         \return the id of the task
+         */
+        size_t AddTask(const std::function<void()>& task, const std::vector<size_t>& dependencies = std::vector<size_t>());
+        
+        //! A method running all tasks of the graph and waiting for them to finish.
+        void Run();
+        
+        //! A method removing all tasks from the graph.
+        void Clear();
+        
+        //! A method returning the number of tasks in the graph.
+        size_t getNumOfTasks() const;
+        
+    private:
+        struct Node
+        {
+            std::function<void()> task;
+            std::vector<size_t> successors;
+            size_t numDependencies;
+        };
+        
+        void RunNode(size_t id);
+        
+        std::vector<Node> nodes;
+        std::vector<std::atomic<size_t>> remaining;
+        std::atomic<size_t> pending;
+    };
+}
+
+#endif
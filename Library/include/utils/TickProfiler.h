@@ -0,0 +1,147 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  TickProfiler.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish_TickProfiler__
+#define __Stonefish_TickProfiler__
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace sf
+{
+    //! A structure holding the summary of a single profiled scope.
+    struct TickProfilerEntry
+    {
+        std::string name; //!< Name of the scope
+        unsigned int depth; //!< Depth of the scope in the hierarchy
+        double averageTime; //!< Average duration of the scope [us]
+        double load; //!< Fraction of the summary window spent in the scope
+        unsigned int calls; //!< Number of calls in the summary window
+    };
+    
+    //! A static class implementing a hierarchical scoped-timer profiler.
+    /*!
+     Each thread records the finished scopes in its own ring buffer, without any locks. Each slot of the buffer carries
+     a sequence number, so that readers skip the events overwritten while being copied.
+     The recorded events can be summarized or exported to the Chrome trace format (chrome://tracing).
+     The zones of the physics engine are recorded together with the scopes of the simulator.
+     */
+    class TickProfiler
+    {
+    public:
+        //! A static method to enable or disable the recording of events.
+        /*!
+         \param enabled a flag to set
+         */
+        static void Enable(bool enabled);
+        
+        //! A static method to check if the profiler is recording.
+        static bool isEnabled();
+        
+        //! A static method to begin a scope in the current thread.
+        /*!
+         \param name the name of the scope (has to stay valid for the lifetime of the program)
+         \param parent the name of the parent scope, used if no scope is open in the current thread
+         */
+        static void Begin(const char* name, const char* parent = nullptr);
+        
+        //! A static method to end the last scope opened in the current thread.
+        static void End();
+        
+        //! A static method to record the value of a counter (e.g. a rate) in the current thread.
+        /*!
+         \param name the name of the counter (has to stay valid for the lifetime of the program)
+         \param value the value of the counter
+         */
+        static void Counter(const char* name, double value);
+        
+        //! A static method returning a permanent copy of a name, to be used as a scope name.
+        /*!
+         \param name the name to copy
+         \return a pointer to a string valid for the lifetime of the program
+         */
+        static const char* Intern(const std::string& name);
+        
+        //! A static method to remove all recorded events.
+        static void Clear();
+        
+        //! A static method summarizing the recent events.
+        /*!
+         \param window the length of the summary window, counted back from now [s]
+         \return a list of scopes ordered as a tree, depth first
+         */
+        static std::vector<TickProfilerEntry> Summarize(double window = 1.0);
+        
+        //! A static method summarizing the recent values of the counters.
+        /*!
+         \param window the length of the summary window, counted back from now [s]
+         \return a list of counter names and their average values
+         */
+        static std::vector<std::pair<std::string, double>> SummarizeCounters(double window = 1.0);
+        
+        //! A static method to export the recorded events to a Chrome trace file.
+        /*!
+         \param filename the path to the output file
+         \return success
+         */
+        static bool ExportChromeTrace(const std::string& filename);
+        
+    private:
+        TickProfiler() {}
+        static int64_t Now();
+        
+        static std::atomic<bool> enabled;
+    };
+    
+    //! A class representing a profiled scope, lasting until the object is destroyed.
+    class ProfileScope
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param name the name of the scope (has to stay valid for the lifetime of the program)
+         \param parent the name of the parent scope, used if no scope is open in the current thread
+         */
+        ProfileScope(const char* name, const char* parent = nullptr) { TickProfiler::Begin(name, parent); }
+        
+        //! A constructor.
+        /*!
+         \param name the name of the scope (copied when the profiler is enabled)
+         \param parent the name of the parent scope, used if no scope is open in the current thread
+         */
+        ProfileScope(const std::string& name, const char* parent = nullptr) { TickProfiler::Begin(TickProfiler::isEnabled() ? TickProfiler::Intern(name) : nullptr, parent); }
+        
+        //! A destructor.
+        ~ProfileScope() { TickProfiler::End(); }
+        
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+}
+
+#endif
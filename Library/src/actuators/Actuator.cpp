@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLContent.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -61,6 +62,16 @@ std::string Actuator::getName() const
     return name;
 }
 
+void Actuator::SaveState(StateBuffer& state) const
+{
+    state.Write(watchdog);
+}
+
+void Actuator::RestoreState(StateReader& state)
+{
+    state.Read(watchdog);
+}
+
 void Actuator::Update(Scalar dt)
 {
     if(watchdogTimeout > Scalar(0))
@@ -24,6 +24,7 @@
 //
 
 #include "actuators/DCMotor.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -103,6 +104,22 @@ Scalar DCMotor::getAngularVelocity() const
     return angularV * gearRatio;
 }
 
+void DCMotor::SaveState(StateBuffer& state) const
+{
+    Motor::SaveState(state);
+    state.Write(V);
+    state.Write(I);
+    state.Write(lastVoverL);
+}
+
+void DCMotor::RestoreState(StateReader& state)
+{
+    Motor::RestoreState(state);
+    state.Read(V);
+    state.Read(I);
+    state.Read(lastVoverL);
+}
+
 void DCMotor::Update(Scalar dt)
 {
     //Get joint angular velocity in radians
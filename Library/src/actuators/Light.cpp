@@ -126,7 +126,7 @@ void Light::InitGraphics()
         glLight = new OpenGLPointLight(glm::vec3(0.f), (GLfloat)R, c.rgb, (GLfloat)Fi);
     
     UpdateTransform();
-    glLight->UpdateTransform();
+    glLight->UpdateTransform(glLight->getPendingPose());
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddLight(glLight);
 }
     
@@ -27,6 +27,7 @@
 
 #include "joints/RevoluteJoint.h"
 #include "entities/FeatherstoneEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -94,6 +95,18 @@ Scalar Motor::getAngularVelocity() const
         return Scalar(0);
 }
 
+void Motor::SaveState(StateBuffer& state) const
+{
+    JointActuator::SaveState(state);
+    state.Write(torque);
+}
+
+void Motor::RestoreState(StateReader& state)
+{
+    JointActuator::RestoreState(state);
+    state.Read(torque);
+}
+
 void Motor::Update(Scalar dt)
 {
     Actuator::Update(dt);
@@ -30,6 +30,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -100,6 +101,28 @@ Scalar Propeller::getTorque() const
     return torque;
 }
 
+void Propeller::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(theta);
+    state.Write(omega);
+    state.Write(thrust);
+    state.Write(torque);
+    state.Write(setpoint);
+    state.Write(iError);
+}
+
+void Propeller::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(theta);
+    state.Read(omega);
+    state.Read(thrust);
+    state.Read(torque);
+    state.Read(setpoint);
+    state.Read(iError);
+}
+
 void Propeller::Update(Scalar dt)
 {
     Actuator::Update(dt);
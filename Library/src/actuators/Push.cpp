@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -63,6 +64,18 @@ Scalar Push::getForce() const
     return setpoint;
 }
 
+void Push::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(setpoint);
+}
+
+void Push::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(setpoint);
+}
+
 void Push::Update(Scalar dt)
 {    
     Actuator::Update(dt);
@@ -30,6 +30,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -78,6 +79,24 @@ Scalar Rudder::getAngle() const
     return theta;
 }
 
+void Rudder::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(theta);
+    state.Write(setpoint);
+    state.Write(liftV);
+    state.Write(dragV);
+}
+
+void Rudder::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(theta);
+    state.Read(setpoint);
+    state.Read(liftV);
+    state.Read(dragV);
+}
+
 void Rudder::Update(Scalar dt)
 {
     //Update rudder angle
@@ -29,6 +29,7 @@
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
 #include "joints/RevoluteJoint.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -186,6 +187,22 @@ void Servo::AttachToJoint(Joint* joint)
     }
 }
 
+void Servo::SaveState(StateBuffer& state) const
+{
+    JointActuator::SaveState(state);
+    state.Write(mode);
+    state.Write(pSetpoint);
+    state.Write(vSetpoint);
+}
+
+void Servo::RestoreState(StateReader& state)
+{
+    JointActuator::RestoreState(state);
+    state.Read(mode);
+    state.Read(pSetpoint);
+    state.Read(vSetpoint);
+}
+
 void Servo::Update(Scalar dt)
 {
     Actuator::Update(dt);
@@ -30,6 +30,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -95,6 +96,26 @@ Scalar SimpleThruster::getTorque() const
     return torque;
 }
 
+void SimpleThruster::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(theta);
+    state.Write(thrust);
+    state.Write(torque);
+    state.Write(sThrust);
+    state.Write(sTorque);
+}
+
+void SimpleThruster::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(theta);
+    state.Read(thrust);
+    state.Read(torque);
+    state.Read(sThrust);
+    state.Read(sTorque);
+}
+
 void SimpleThruster::Update(Scalar dt)
 {
     Actuator::Update(dt);
@@ -25,10 +25,12 @@
 
 #include "actuators/SuctionCup.h"
 
+#include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/FeatherstoneEntity.h"
 #include "joints/SpringJoint.h"
 #include "joints/SphericalJoint.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -72,6 +74,27 @@ void SuctionCup::AttachToLink(FeatherstoneEntity* multibody, unsigned int linkId
     attachLinkId = linkId;
 }
 
+void SuctionCup::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(pump);
+}
+
+void SuctionCup::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(pump);
+    
+    //Suction joint is released, the cup engages again on contact if the pump is on
+    if(joint != nullptr)
+    {
+        if(joint->isMultibodyJoint())
+            joint->getSolidB()->getRigidBody()->setDamping(0.0, 0.0);
+        SimulationApp::getApp()->getSimulationManager()->RemoveJoint(joint);
+        joint = nullptr;
+    }
+}
+
 void SuctionCup::Update(Scalar dt)
 {
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include <algorithm>
+#include "utils/StateBuffer.h"
 
 namespace sf 
 {
@@ -45,11 +46,9 @@ VariableBuoyancy::VariableBuoyancy(std::string uniqueName, const std::vector<std
     
     for(size_t i=0; i<volumeMeshPaths.size(); ++i)
     {
-        Mesh* mesh = LoadGeometryFromFile(volumeMeshPaths[i], 1.f);
-        if(mesh == NULL)
-            abort();
-        Vprops.push_back(ComputePhysicalProperties(mesh, Scalar(0), density));
-        delete mesh;
+        const ProcessedGeometry* geom = LoadProcessedGeometry(volumeMeshPaths[i], 1.f, 0.f, Scalar(0), density);
+        Vprops.push_back(geom->properties);
+        ReleaseMesh(geom->mesh);
     }
     auto volumeCompare = [](MeshProperties& mp1, MeshProperties& mp2) { return mp1.volume < mp2.volume; };
     std::sort(Vprops.begin(), Vprops.end(), volumeCompare);
@@ -119,6 +118,24 @@ void VariableBuoyancy::InterpolateVProps(Scalar volume, Scalar& m, Vector3& cg)
     }
 }
     
+void VariableBuoyancy::SaveState(StateBuffer& state) const
+{
+    LinkActuator::SaveState(state);
+    state.Write(V);
+    state.Write(CG);
+    state.Write(flowRate);
+    state.Write(force);
+}
+
+void VariableBuoyancy::RestoreState(StateReader& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(V);
+    state.Read(CG);
+    state.Read(flowRate);
+    state.Read(force);
+}
+
 void VariableBuoyancy::Update(Scalar dt)
 {
     Ocean* ocn = SimulationApp::getApp()->getSimulationManager()->getOcean();
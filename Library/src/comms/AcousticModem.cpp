@@ -29,6 +29,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -101,11 +102,12 @@ bool AcousticModem::mutualContact(uint64_t device1Id, uint64_t device2Id)
         
     if(node1->getOcclusionTest() || node2->getOcclusionTest())
     {
-        btCollisionWorld::ClosestRayResultCallback closest(pos1, pos2);
-        closest.m_collisionFilterGroup = MASK_DYNAMIC;
-        closest.m_collisionFilterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING;
-        SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(pos1, pos2, closest);
-        return !closest.hasHit();
+        static thread_local RayBatch rays;
+        static thread_local RayHits hits;
+        rays.Clear();
+        rays.AddRay(pos1, pos2);
+        SimulationApp::getApp()->getSimulationManager()->RayTest(rays, hits);
+        return !hits.hasHit(0);
     }
     else
         return true;
@@ -226,6 +228,57 @@ void AcousticModem::ProcessMessages()
     }
 }
 
+void AcousticModem::SaveFrame(StateBuffer& state, const CommDataFrame* frame) const
+{
+    Comm::SaveFrame(state, frame);
+    state.Write(((const AcousticDataFrame*)frame)->txPosition);
+    state.Write(((const AcousticDataFrame*)frame)->travelled);
+}
+
+CommDataFrame* AcousticModem::RestoreFrame(StateReader& state) const
+{
+    AcousticDataFrame* frame = new AcousticDataFrame();
+    state.Read(frame->timeStamp);
+    state.Read(frame->seq);
+    state.Read(frame->source);
+    state.Read(frame->destination);
+    state.Read(frame->data);
+    state.Read(frame->txPosition);
+    state.Read(frame->travelled);
+    return frame;
+}
+
+void AcousticModem::SaveState(StateBuffer& state) const
+{
+    Comm::SaveState(state);
+    state.Write(position);
+    state.Write(frame);
+    state.Write((uint64_t)propagating.size());
+    for(auto it = propagating.begin(); it != propagating.end(); ++it)
+    {
+        SaveFrame(state, it->first);
+        state.Write(it->second);
+    }
+}
+
+void AcousticModem::RestoreState(StateReader& state)
+{
+    Comm::RestoreState(state);
+    state.Read(position);
+    state.Read(frame);
+    
+    for(auto it = propagating.begin(); it != propagating.end(); ++it)
+        delete it->first;
+    propagating.clear();
+    uint64_t n = 0;
+    state.Read(n);
+    for(uint64_t i=0; i<n && state.isValid(); ++i)
+    {
+        AcousticDataFrame* msg = (AcousticDataFrame*)RestoreFrame(state);
+        state.Read(propagating[msg]);
+    }
+}
+
 void AcousticModem::InternalUpdate(Scalar dt)
 {
     //Propagate messages already sent
@@ -30,6 +30,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "entities/MovingEntity.h"
 #include "entities/StaticEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -45,6 +46,7 @@ Comm::Comm(std::string uniqueName, uint64_t deviceId)
     attach = nullptr;
     o2c = I4();
     txSeq = 0;
+    randomGenerator.seed(0); //Reseeded by the simulation manager when the comm is added
 }
 
 Comm::~Comm()
@@ -101,6 +103,11 @@ bool Comm::isRenderable()
     return renderable;
 }
 
+void Comm::setRandomSeed(unsigned int seed)
+{
+    randomGenerator.seed(seed);
+}
+
 void Comm::Connect(uint64_t deviceId)
 {
     cId = deviceId;
@@ -161,6 +168,66 @@ void Comm::AttachToSolid(MovingEntity* body, const Transform& origin)
     }
 }
 
+void Comm::SaveFrame(StateBuffer& state, const CommDataFrame* frame) const
+{
+    state.Write(frame->timeStamp);
+    state.Write(frame->seq);
+    state.Write(frame->source);
+    state.Write(frame->destination);
+    state.Write(frame->data);
+}
+
+CommDataFrame* Comm::RestoreFrame(StateReader& state) const
+{
+    CommDataFrame* frame = new CommDataFrame();
+    state.Read(frame->timeStamp);
+    state.Read(frame->seq);
+    state.Read(frame->source);
+    state.Read(frame->destination);
+    state.Read(frame->data);
+    return frame;
+}
+
+void Comm::SaveState(StateBuffer& state) const
+{
+    SDL_LockMutex(updateMutex);
+    state.Write(newDataAvailable);
+    state.Write(txSeq);
+    state.Write(randomGenerator);
+    state.Write((uint64_t)txBuffer.size());
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        SaveFrame(state, txBuffer[i]);
+    state.Write((uint64_t)rxBuffer.size());
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        SaveFrame(state, rxBuffer[i]);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void Comm::RestoreState(StateReader& state)
+{
+    SDL_LockMutex(updateMutex);
+    state.Read(newDataAvailable);
+    state.Read(txSeq);
+    state.Read(randomGenerator);
+    
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        delete txBuffer[i];
+    txBuffer.clear();
+    uint64_t n = 0;
+    state.Read(n);
+    for(uint64_t i=0; i<n && state.isValid(); ++i)
+        txBuffer.push_back(RestoreFrame(state));
+    
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        delete rxBuffer[i];
+    rxBuffer.clear();
+    n = 0;
+    state.Read(n);
+    for(uint64_t i=0; i<n && state.isValid(); ++i)
+        rxBuffer.push_back(RestoreFrame(state));
+    SDL_UnlockMutex(updateMutex);
+}
+
 void Comm::Update(Scalar dt)
 {
     SDL_LockMutex(updateMutex);
@@ -24,13 +24,11 @@
 //
 
 #include "comms/USBL.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
     
-std::random_device USBL::randomDevice;
-std::mt19937 USBL::randomGenerator(randomDevice());
-    
 USBL::USBL(std::string uniqueName, uint64_t deviceId, Scalar minVerticalFOVDeg, Scalar maxVerticalFOVDeg, Scalar operatingRange)
            : AcousticModem(uniqueName, deviceId, minVerticalFOVDeg, maxVerticalFOVDeg, operatingRange)
 {
@@ -63,6 +61,35 @@ void USBL::DisableAutoPing()
     ping = false;
 }
 
+void USBL::SaveState(StateBuffer& state) const
+{
+    AcousticModem::SaveState(state);
+    state.Write(ping);
+    state.Write(pingTime);
+    state.Write((uint64_t)beacons.size());
+    for(auto it = beacons.begin(); it != beacons.end(); ++it)
+    {
+        state.Write(it->first);
+        state.Write(it->second);
+    }
+}
+
+void USBL::RestoreState(StateReader& state)
+{
+    AcousticModem::RestoreState(state);
+    state.Read(ping);
+    state.Read(pingTime);
+    beacons.clear();
+    uint64_t n = 0;
+    state.Read(n);
+    for(uint64_t i=0; i<n && state.isValid(); ++i)
+    {
+        uint64_t beaconId = 0;
+        state.Read(beaconId);
+        state.Read(beacons[beaconId]);
+    }
+}
+
 void USBL::InternalUpdate(Scalar dt)
 {
     AcousticModem::InternalUpdate(dt);
@@ -0,0 +1,166 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BatchSimulationApp.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "core/BatchSimulationApp.h"
+
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include "core/SimulationManager.h"
+#include "utils/GeometryFileUtil.h"
+#include "utils/TaskScheduler.h"
+
+namespace sf
+{
+
+BatchSimulationApp::BatchSimulationApp(std::string name, std::string dataDirPath, const std::vector<SimulationManager*>& worlds, 
+                                       unsigned int numThreads, unsigned int stepsPerBatch)
+: SimulationApp(name, dataDirPath, worlds.size() > 0 ? worlds[0] : nullptr)
+{
+    if(worlds.size() == 0)
+        cCritical("Batch simulation requires at least one world!");
+    
+    this->worlds = worlds;
+    nThreads = numThreads > 0 ? (int)numThreads : (int)std::max(std::thread::hardware_concurrency(), 1u);
+    batchSteps = stepsPerBatch > 0 ? stepsPerBatch : 1;
+    simulationThread = NULL;
+}
+
+BatchSimulationApp::~BatchSimulationApp()
+{
+    ClearGeometryCache();
+    EnableGeometryCache(false);
+    TaskScheduler::setLocked(false);
+    delete console;
+}
+
+bool BatchSimulationApp::hasGraphics()
+{
+    return false;
+}
+
+size_t BatchSimulationApp::getNumOfWorlds() const
+{
+    return worlds.size();
+}
+
+SimulationManager* BatchSimulationApp::getWorld(size_t index)
+{
+    if(index < worlds.size())
+        return worlds[index];
+    else
+        return nullptr;
+}
+
+void BatchSimulationApp::ForEachWorld(const std::function<void(SimulationManager*)>& func, size_t first)
+{
+    //Tasks of the simulation tick are run by the same pool of threads, idle threads help the busy worlds
+    TaskScheduler::ParallelFor(first, worlds.size(), [this, &func](size_t i)
+    {
+        SimulationApp::setThreadSimulationManager(worlds[i]);
+        func(worlds[i]);
+        SimulationApp::setThreadSimulationManager(nullptr);
+    });
+}
+
+void BatchSimulationApp::StepWorlds(unsigned int steps)
+{
+    ForEachWorld([steps](SimulationManager* sim) { sim->StepSimulation(steps); });
+}
+
+void BatchSimulationApp::Init()
+{
+    SimulationApp::Init();
+    TaskScheduler::Init(nThreads);
+    TaskScheduler::setLocked(true); //The number of threads of the application overrides the scenario settings
+    cInfo("Initializing batch simulation (%d worlds, %d threads):", (int)worlds.size(), nThreads);
+    InitializeSimulation();
+    cInfo("Ready for running...");
+}
+
+void BatchSimulationApp::InitializeSimulation()
+{
+    //Geometry files are parsed once and shared between all worlds
+    EnableGeometryCache(true);
+    
+    cInfo("Building scenarios...");
+    ForEachWorld([](SimulationManager* sim)
+    {
+        sim->RestartScenario();
+        sim->getDynamicsWorld()->synchronizeMotionStates();
+        sim->setFreeRunning(true);
+    });
+    cInfo("Simulation initialized -> using Bullet Physics %d.%d.", btGetVersion()/100, btGetVersion()%100);
+}
+
+void BatchSimulationApp::LoopInternal()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+void BatchSimulationApp::StartSimulation()
+{
+    ForEachWorld([](SimulationManager* sim) { sim->StartSimulation(); }, 1);
+    SimulationApp::StartSimulation(); //First world
+    
+    BatchSimulationThreadData* data = new BatchSimulationThreadData();
+    data->app = this;
+    simulationThread = SDL_CreateThread(BatchSimulationApp::RunSimulation, "simulationThread", data);
+}
+
+void BatchSimulationApp::ResumeSimulation()
+{
+    ForEachWorld([](SimulationManager* sim) { sim->ResumeSimulation(); }, 1);
+    SimulationApp::ResumeSimulation(); //First world
+    
+    BatchSimulationThreadData* data = new BatchSimulationThreadData();
+    data->app = this;
+    simulationThread = SDL_CreateThread(BatchSimulationApp::RunSimulation, "simulationThread", data);
+}
+
+void BatchSimulationApp::StopSimulation()
+{
+    SimulationApp::StopSimulation(); //First world
+    
+    int status;
+    SDL_WaitThread(simulationThread, &status);
+    simulationThread = NULL;
+    
+    ForEachWorld([](SimulationManager* sim) { sim->StopSimulation(); }, 1);
+}
+
+//Static
+int BatchSimulationApp::RunSimulation(void* data)
+{
+    BatchSimulationThreadData* stdata = (BatchSimulationThreadData*)data;
+    BatchSimulationApp* app = stdata->app;
+    
+    while(app->isRunning())
+        app->StepWorlds(app->batchSteps);
+    
+    return 0;
+}
+
+}
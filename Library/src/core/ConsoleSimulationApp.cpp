@@ -27,7 +27,6 @@
 
 #include <chrono>
 #include <thread>
-#include <omp.h>
 #include "core/SimulationManager.h"
 #include "utils/SystemUtil.hpp"
 
@@ -95,9 +94,6 @@ int ConsoleSimulationApp::RunSimulation(void* data)
 {
     ConsoleSimulationThreadData* stdata = (ConsoleSimulationThreadData*)data;
     SimulationManager* sim = stdata->app->getSimulationManager();
-
-    int maxThreads = std::max(omp_get_max_threads()/2, 1);
-    omp_set_num_threads(maxThreads);
     
     while(stdata->app->isRunning())
         sim->AdvanceSimulation();
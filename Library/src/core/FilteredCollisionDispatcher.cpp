@@ -26,7 +26,6 @@
 #include "core/FilteredCollisionDispatcher.h"
 
 #include "BulletDynamics/Dynamics/btRigidBody.h"
-#include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/SolidEntity.h"
 #include "sensors/Contact.h"
@@ -34,8 +33,9 @@
 namespace sf
 {
 
-FilteredCollisionDispatcher::FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, bool inclusiveMode) : btCollisionDispatcher(collisionConfiguration)
+FilteredCollisionDispatcher::FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, SimulationManager* sm, bool inclusiveMode) : btCollisionDispatcher(collisionConfiguration)
 {
+    sim = sm;
     inclusive = inclusiveMode;
     // setNearCallback(myNearCallback);
 }
@@ -55,9 +55,9 @@ bool FilteredCollisionDispatcher::needsCollision(const btCollisionObject* body0,
         return false;
 
     if(inclusive)
-        needs = SimulationApp::getApp()->getSimulationManager()->CheckCollision(ent0, ent1) > -1;
+        needs = sim->CheckCollision(ent0, ent1) > -1;
     else //exclusive
-        needs = SimulationApp::getApp()->getSimulationManager()->CheckCollision(ent0, ent1) == -1;
+        needs = sim->CheckCollision(ent0, ent1) == -1;
     
     return needs;
 }
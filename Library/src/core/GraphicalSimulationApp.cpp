@@ -26,8 +26,8 @@
 #include "core/GraphicalSimulationApp.h"
 
 #include <chrono>
+#include <filesystem>
 #include <thread>
-#include <omp.h>
 #include "core/SimulationManager.h"
 #include "core/Robot.h"
 #include "graphics/OpenGLState.h"
@@ -37,6 +37,7 @@
 #include "graphics/IMGUI.h"
 #include "graphics/OpenGLTrackball.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/TickProfiler.h"
 #include "entities/Entity.h"
 #include "entities/StaticEntity.h"
 #include "entities/SolidEntity.h"
@@ -63,6 +64,7 @@ GraphicalSimulationApp::GraphicalSimulationApp(std::string name, std::string dat
     displayKeymap = false;
     displayConsole = false;
     displayPerformance = false;
+    profilerSummaryTime = 0;
     joystick = NULL;
     joystickAxes = NULL;
     joystickButtons = NULL;
@@ -189,10 +191,12 @@ void GraphicalSimulationApp::Init()
     //General initialization
     SimulationApp::Init();
     //Window initialization + loading thread
+    int64_t t0 = GetTimeInMicroseconds();
     loading = true;
     InitializeSDL();
 
     //Continue initialization with console visible
+    int64_t t1 = GetTimeInMicroseconds();
     cInfo("Initializing rendering pipeline:");
     cInfo("Loading GUI...");
     gui = new IMGUI(windowW, windowH);
@@ -200,8 +204,17 @@ void GraphicalSimulationApp::Init()
     glPipeline = new OpenGLPipeline(rSettings, hSettings);
     ShowHUD();
     
+    int64_t t2 = GetTimeInMicroseconds();
     cInfo("Initializing simulation:");
     InitializeSimulation();
+    int64_t t3 = GetTimeInMicroseconds();
+    
+    //Startup timing report
+    GLSLProgramStats shaderStats = GLSLShader::getProgramStats();
+    cInfo("Startup took %1.3lf s (window %1.3lf s, rendering pipeline %1.3lf s, simulation %1.3lf s).",
+          (t3-t0)/1e6, (t1-t0)/1e6, (t2-t1)/1e6, (t3-t2)/1e6);
+    cInfo("Shader programs: %u compiled in %1.3lf s, %u loaded from cache in %1.3lf s.",
+          shaderStats.compiledPrograms, shaderStats.compileTime, shaderStats.cachedPrograms, shaderStats.cacheTime);
     
     cInfo("Ready for running...");
     SDL_Delay(1000);
@@ -285,6 +298,8 @@ void GraphicalSimulationApp::InitializeSDL()
     //Initialize OpenGL pipeline
     cInfo("Window created. OpenGL %d.%d contexts created.", vmajor, vminor);
     OpenGLState::Init();
+    if(getCacheDirectory() != "")
+        GLSLShader::EnableProgramCache((std::filesystem::path(getCacheDirectory()) / "shaders").string());
     GLSLShader::Init();
     
     //Initialize console output
@@ -373,6 +388,17 @@ void GraphicalSimulationApp::KeyDown(SDL_Event *event)
 
         case SDLK_p:
             displayPerformance = !displayPerformance;
+            TickProfiler::Enable(displayPerformance);
+            break;
+            
+        case SDLK_t:
+        {
+            std::string traceFile = "stonefish_trace.json";
+            if(TickProfiler::ExportChromeTrace(traceFile))
+                cInfo("Profiler trace exported to: %s", traceFile.c_str());
+            else
+                cError("Failed to export profiler trace to: %s", traceFile.c_str());
+        }
             break;
 
         case SDLK_c:
@@ -998,11 +1024,13 @@ void GraphicalSimulationApp::DoHUD()
     //Keymap
     if(displayKeymap)
     {
-        offset = getWindowHeight()-278.f;
+        offset = getWindowHeight()-310.f;
         GLfloat left = getWindowWidth()-130.f; 
-        gui->DoPanel(left - 10.f, offset, 130.f, 238.f); offset += 10.f;
+        gui->DoPanel(left - 10.f, offset, 130.f, 270.f); offset += 10.f;
         gui->DoLabel(left, offset, "[H] show/hide GUI"); offset += 16.f;
         gui->DoLabel(left, offset, "[C] show/hide console"); offset += 16.f;
+        gui->DoLabel(left, offset, "[P] show/hide profiler"); offset += 16.f;
+        gui->DoLabel(left, offset, "[T] export trace"); offset += 16.f;
         gui->DoLabel(left, offset, "[W] move forward"); offset += 16.f;
         gui->DoLabel(left, offset, "[S] move backward"); offset += 16.f;
         gui->DoLabel(left, offset, "[A] move left"); offset += 16.f;
@@ -1023,10 +1051,43 @@ void GraphicalSimulationApp::DoHUD()
         std::vector<std::vector<GLfloat> > perfData;    
         perfData.push_back(getSimulationManager()->getPerformanceMonitor().getPhysicsTimeHistory<GLfloat>(100));
         perfData.push_back(getSimulationManager()->getPerformanceMonitor().getHydrodynamicsTimeHistory<GLfloat>(100));
+        perfData.push_back(getSimulationManager()->getPerformanceMonitor().getSensorsTimeHistory<GLfloat>(100));
 
         id.owner = 4;
         id.item = 0;
         gui->DoTimePlot(id, getWindowWidth()-300, getWindowHeight()-200, 290, 160, perfData, "Performance Monitor", new Scalar[2]{-1, 10000});
+        
+        //Profiler summary (refreshed twice per second)
+        int64_t now = GetTimeInMicroseconds();
+        if(now - profilerSummaryTime > 500000)
+        {
+            profilerSummary = TickProfiler::Summarize(1.0);
+            profilerCounters = TickProfiler::SummarizeCounters(1.0);
+            profilerSummaryTime = now;
+        }
+        
+        size_t rows = std::min(profilerSummary.size(), (size_t)24);
+        size_t counterRows = std::min(profilerCounters.size(), (size_t)8);
+        GLfloat left = getWindowWidth()-300.f;
+        offset = getWindowHeight()-210.f-(rows+counterRows+1)*14.f-10.f;
+        gui->DoPanel(left, offset, 290.f, (rows+counterRows+1)*14.f+10.f); offset += 10.f;
+        gui->DoLabel(left + 5.f, offset, "PROFILER");
+        gui->DoLabel(left + 190.f, offset, "[us]   [%]"); offset += 14.f;
+        for(size_t i=0; i<rows; ++i)
+        {
+            const TickProfilerEntry& e = profilerSummary[i];
+            gui->DoLabel(left + 5.f + e.depth * 8.f, offset, e.name.substr(0, 28 - std::min(e.depth, 20u)));
+            std::sprintf(buf, "%6.0lf %5.1lf", e.averageTime, e.load * 100.0);
+            gui->DoLabel(left + 190.f, offset, buf);
+            offset += 14.f;
+        }
+        for(size_t i=0; i<counterRows; ++i)
+        {
+            gui->DoLabel(left + 5.f, offset, profilerCounters[i].first.substr(0, 28));
+            std::sprintf(buf, "%12.3lf", profilerCounters[i].second);
+            gui->DoLabel(left + 190.f, offset, buf);
+            offset += 14.f;
+        }
     }
 }
 
@@ -1036,7 +1097,6 @@ void GraphicalSimulationApp::StartSimulation()
     
     GraphicalSimulationThreadData* data = new GraphicalSimulationThreadData();
     data->app = this;
-    data->drawingQueueMutex = glPipeline->getDrawingQueueMutex();
     simulationThread = SDL_CreateThread(GraphicalSimulationApp::RunSimulation, "simulationThread", data);
 }
 
@@ -1046,7 +1106,6 @@ void GraphicalSimulationApp::ResumeSimulation()
     
     GraphicalSimulationThreadData* data = new GraphicalSimulationThreadData();
     data->app = this;
-    data->drawingQueueMutex = glPipeline->getDrawingQueueMutex();
     simulationThread = SDL_CreateThread(GraphicalSimulationApp::RunSimulation, "simulationThread", data);
 }
 
@@ -1123,19 +1182,14 @@ int GraphicalSimulationApp::RunSimulation(void* data)
 {
     GraphicalSimulationThreadData* stdata = (GraphicalSimulationThreadData*)data;
     SimulationManager* sim = stdata->app->getSimulationManager();
-
-    int maxThreads = std::max(omp_get_max_threads()/2, 1);
-    omp_set_num_threads(maxThreads);
+    OpenGLPipeline* glPipeline = stdata->app->getGLPipeline();
     
     while(stdata->app->isRunning())
     {
         sim->AdvanceSimulation();
-        if(stdata->app->getGLPipeline()->isDrawingQueueEmpty())
-        {
-            SDL_LockMutex(stdata->drawingQueueMutex);
+        //Rebuild the drawing queue only when the renderer took the last one (never waits)
+        if(!glPipeline->isDrawingQueuePending())
             sim->UpdateDrawingQueue();
-            SDL_UnlockMutex(stdata->drawingQueueMutex);
-        }
     }
     
     return 0;
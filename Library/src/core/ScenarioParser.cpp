@@ -82,11 +82,26 @@
 #include "joints/FixedJoint.h"
 #include "graphics/OpenGLDataStructs.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/GeometryFileUtil.h"
+#include "utils/TaskScheduler.h"
 #include "tinyexpr.h"
+#include <memory>
+#include <mutex>
+#include <typeinfo>
 
 namespace sf
 {
 
+struct CachedScenarioFile
+{
+    std::string stamp; //Path, size and modification time of the file
+    std::unique_ptr<XMLDocument> doc; //Pre-processed contents
+};
+
+static bool scenarioCacheEnabled = false;
+static std::map<std::string, CachedScenarioFile> scenarioCache;
+static std::mutex scenarioCacheMutex;
+
 ScenarioParser::ScenarioParser(SimulationManager* sm) : log(false), sm(sm)
 {
     graphical = SimulationApp::getApp()->hasGraphics();
@@ -102,13 +117,38 @@ SimulationManager* ScenarioParser::getSimulationManager()
     return sm;
 }
 
+void ScenarioParser::EnableScenarioCache(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(scenarioCacheMutex);
+        scenarioCacheEnabled = enabled;
+    }
+    EnableGeometryCache(enabled);
+    RetainProcessedGeometry(enabled);
+    if(!enabled)
+        ClearScenarioCache();
+}
+
+void ScenarioParser::ClearScenarioCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(scenarioCacheMutex);
+        scenarioCache.clear();
+    }
+    ClearGeometryCache();
+    ReleaseUnusedGeometry();
+}
+
 bool ScenarioParser::Parse(std::string filename)
 {
     cInfo("Scenario parser: Loading scenario from '%s'.", filename.c_str());
     log.Print(MessageType::INFO, "Scenario file: %s", filename.c_str());
     
-    //Open file
-    XMLError result = doc.LoadFile(filename.c_str());
+    //Open file (or restore the pre-processed file from the cache)
+    const std::map<std::string, std::string> noArgs;
+    std::string stamp;
+    bool cached = RestoreFromCache(filename, noArgs, doc, stamp);
+    XMLError result = cached ? XML_SUCCESS : doc.LoadFile(filename.c_str());
     if(result != XML_SUCCESS)
     {
         switch(result)
@@ -138,10 +178,14 @@ bool ScenarioParser::Parse(std::string filename)
         return false;
     }
     
-    if(!PreProcess(root))
+    if(!cached)
     {
-        log.Print(MessageType::ERROR, "Pre-processing failed!");
-        return false;
+        if(!PreProcess(root))
+        {
+            log.Print(MessageType::ERROR, "Pre-processing failed!");
+            return false;
+        }
+        StoreInCache(filename, noArgs, stamp, doc);
     }
 
     //Include other scenario files
@@ -177,7 +221,8 @@ bool ScenarioParser::Parse(std::string filename)
         //Load file
         std::string includedPath = GetFullPath(std::string(path));
         XMLDocument includedDoc;
-        result = includedDoc.LoadFile(includedPath.c_str());
+        cached = RestoreFromCache(includedPath, args, includedDoc, stamp);
+        result = cached ? XML_SUCCESS : includedDoc.LoadFile(includedPath.c_str());
         if(result != XML_SUCCESS)
         {
             switch(result)
@@ -210,10 +255,14 @@ bool ScenarioParser::Parse(std::string filename)
             return false;
         }
         
-        if(!PreProcess(includedRoot, args))
+        if(!cached)
         {
-            log.Print(MessageType::ERROR, "Pre-processing of included file '%s' failed!", includedPath.c_str());
-            return false;
+            if(!PreProcess(includedRoot, args))
+            {
+                log.Print(MessageType::ERROR, "Pre-processing of included file '%s' failed!", includedPath.c_str());
+                return false;
+            }
+            StoreInCache(includedPath, args, stamp, includedDoc);
         }
         
         for(const XMLNode* child = includedRoot->FirstChild(); child != nullptr; child = child->NextSibling())
@@ -430,6 +479,44 @@ bool ScenarioParser::SaveLog(std::string filename)
     }
 }
 
+std::string ScenarioParser::GetCacheKey(const std::string& path, const std::map<std::string, std::string>& args)
+{
+    //Derived parsers may pre-process files differently
+    std::string key = std::string(typeid(*this).name()) + "|" + path;
+    for(auto it = args.begin(); it != args.end(); ++it)
+        key += "|" + it->first + "=" + it->second;
+    return key;
+}
+
+bool ScenarioParser::RestoreFromCache(const std::string& path, const std::map<std::string, std::string>& args, XMLDocument& target, std::string& stamp)
+{
+    stamp = "";
+    std::lock_guard<std::mutex> lock(scenarioCacheMutex);
+    if(!scenarioCacheEnabled)
+        return false;
+    
+    //Stamp taken before loading, so that a modification during loading invalidates the entry
+    stamp = MakeGeometryCacheKey(path, "");
+    auto it = scenarioCache.find(GetCacheKey(path, args));
+    if(it == scenarioCache.end() || it->second.stamp != stamp)
+        return false;
+    
+    it->second.doc->DeepCopy(&target);
+    return true;
+}
+
+void ScenarioParser::StoreInCache(const std::string& path, const std::map<std::string, std::string>& args, const std::string& stamp, const XMLDocument& source)
+{
+    std::lock_guard<std::mutex> lock(scenarioCacheMutex);
+    if(!scenarioCacheEnabled || stamp == "")
+        return;
+    
+    CachedScenarioFile& entry = scenarioCache[GetCacheKey(path, args)]; //Replaces outdated entry
+    entry.stamp = stamp;
+    entry.doc = std::unique_ptr<XMLDocument>(new XMLDocument());
+    source.DeepCopy(entry.doc.get());
+}
+
 bool ScenarioParser::PreProcess(XMLNode* root, const std::map<std::string, std::string>& args)
 {
     //Replace arguments passed to the files
@@ -574,6 +661,39 @@ bool ScenarioParser::ParseSolver(XMLElement* element)
     }
 
     sm->setSolverParams(erp, stopErp, erp2, globalDamping, globalFriction, linSleep, angSleep);
+
+    bool adaptiveHydro;
+    if((item = element->FirstChildElement("adaptive_hydrodynamics")) != nullptr
+       && item->QueryAttribute("value", &adaptiveHydro) == XML_SUCCESS)
+    {
+        sm->setAdaptiveHydrodynamics(adaptiveHydro);
+        AdaptiveHydrodynamicsSettings ahs = sm->getAdaptiveHydrodynamicsSettings();
+        item->QueryAttribute("quasi_static_speed", &ahs.quasiStaticSpeed);
+        item->QueryAttribute("quasi_static_change", &ahs.quasiStaticChange);
+        item->QueryAttribute("quasi_static_factor", &ahs.quasiStaticFactor);
+        item->QueryAttribute("min_change", &ahs.minChange);
+        item->QueryAttribute("relative_change", &ahs.relativeChange);
+        sm->setAdaptiveHydrodynamicsSettings(ahs);
+    }
+    
+    unsigned int seed;
+    if((item = element->FirstChildElement("random_seed")) != nullptr
+       && item->QueryAttribute("value", &seed) == XML_SUCCESS)
+        sm->setRandomSeed(seed);
+    
+    if((item = element->FirstChildElement("threads")) != nullptr && !TaskScheduler::isLocked()) //Application can own the settings
+    {
+        unsigned int numThreads = 0;
+        bool pin = TaskScheduler::isPinningThreads();
+        item->QueryAttribute("value", &numThreads);
+        item->QueryAttribute("pin", &pin);
+        if(numThreads == 0)
+            numThreads = TaskScheduler::getNumOfThreads();
+        
+        //Restarting the workers is avoided when the settings do not change (e.g. many worlds loading the same scenario)
+        if(numThreads != TaskScheduler::getNumOfThreads() || pin != TaskScheduler::isPinningThreads())
+            TaskScheduler::Init(numThreads, pin);
+    }
     
     return true;
 }
@@ -1826,6 +1946,9 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             Scalar phyScale(1);
             Transform phyOrigin;
             Scalar thickness(-1);
+            unsigned int lodFaces(0);
+            Scalar lodError(0);
+            CollisionGeometrySettings colSettings;
 
             if((item = element->FirstChildElement("physical")) == nullptr)
             {
@@ -1842,6 +1965,31 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             item2->QueryAttribute("scale", &phyScale);
             if((item2 = item->FirstChildElement("thickness")) != nullptr)
                 item2->QueryAttribute("value", &thickness);
+            if((item2 = item->FirstChildElement("hydro_lod")) != nullptr)
+            {
+                item2->QueryAttribute("faces", &lodFaces);
+                item2->QueryAttribute("error", &lodError);
+            }
+            if((item2 = item->FirstChildElement("collision_shape")) != nullptr)
+            {
+                const char* colType = nullptr;
+                if(item2->QueryStringAttribute("type", &colType) == XML_SUCCESS)
+                {
+                    std::string colTypeStr(colType);
+                    if(colTypeStr == "convex_hull")
+                        colSettings.type = CollisionGeometryType::CONVEX_HULL;
+                    else if(colTypeStr == "decomposition")
+                        colSettings.type = CollisionGeometryType::CONVEX_DECOMPOSITION;
+                    else
+                    {
+                        log.Print(MessageType::ERROR, "Incorrect collision shape type for rigid body '%s'!", solidName.c_str());
+                        return false;
+                    }
+                }
+                item2->QueryAttribute("max_vertices", &colSettings.maxHullVertices);
+                item2->QueryAttribute("max_parts", &colSettings.maxHulls);
+                item2->QueryAttribute("concavity", &colSettings.maxConcavity);
+            }
             if((item2 = item->FirstChildElement("origin")) == nullptr || !ParseTransform(item2, phyOrigin))
             {
                 log.Print(MessageType::ERROR, "Physical mesh of rigid body '%s' not properly defined!", solidName.c_str());
@@ -1872,6 +2020,10 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             {
                 solid = new Polyhedron(solidName, phy, GetFullPath(std::string(phyMesh)), phyScale, phyOrigin, std::string(mat), std::string(look), thickness); 
             }
+            
+            ((Polyhedron*)solid)->setCollisionGeometry(colSettings);
+            if(lodFaces > 0 || lodError > Scalar(0))
+                solid->setHydrodynamicsMeshLOD(lodFaces, lodError);
         }
         else
         {
@@ -25,8 +25,11 @@
 
 #include "core/SimulationApp.h"
 
+#include <cstdlib>
+#include <filesystem>
 #include "core/SimulationManager.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/GeometryFileUtil.h"
 
 namespace sf
 {
@@ -36,6 +39,14 @@ SimulationApp::SimulationApp(std::string name, std::string dataDirPath, Simulati
     SimulationApp::handle = this;
 	appName = name;
     dataPath = dataDirPath;
+    const char* xdgCache = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if(xdgCache != nullptr && xdgCache[0] != '\0')
+        cacheDir = (std::filesystem::path(xdgCache) / "stonefish").string();
+    else if(home != nullptr && home[0] != '\0')
+        cacheDir = (std::filesystem::path(home) / ".cache" / "stonefish").string();
+    else
+        cacheDir = "";
     simulation = sim;
     finished = false;
     running = false;
@@ -56,7 +67,7 @@ SimulationApp::~SimulationApp()
 
 SimulationManager* SimulationApp::getSimulationManager()
 {
-    return simulation;
+    return threadSimulation != nullptr ? threadSimulation : simulation;
 }
 
 double SimulationApp::getPhysicsTime()
@@ -84,6 +95,16 @@ std::string SimulationApp::getName()
 	return appName;
 }
 
+void SimulationApp::setCacheDirectory(const std::string& path)
+{
+    cacheDir = path;
+}
+
+std::string SimulationApp::getCacheDirectory()
+{
+    return cacheDir;
+}
+
 Console* SimulationApp::getConsole()
 {
     return console;
@@ -91,6 +112,7 @@ Console* SimulationApp::getConsole()
 
 void SimulationApp::Init()
 {
+    EnableMeshCache(cacheDir != "" ? (std::filesystem::path(cacheDir) / "geometry").string() : "");
 }
 
 void SimulationApp::InitializeSimulation()
@@ -147,10 +169,21 @@ void SimulationApp::CleanUp()
 
 //Static
 SimulationApp* SimulationApp::handle = NULL;
+thread_local SimulationManager* SimulationApp::threadSimulation = nullptr;
 
 SimulationApp* SimulationApp::getApp()
 {
     return SimulationApp::handle;
 }
 
+void SimulationApp::setThreadSimulationManager(SimulationManager* sim)
+{
+    SimulationApp::threadSimulation = sim;
+}
+
+SimulationManager* SimulationApp::getThreadSimulationManager()
+{
+    return SimulationApp::threadSimulation;
+}
+
 }
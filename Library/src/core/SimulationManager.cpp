@@ -37,7 +37,6 @@
 #include <chrono>
 #include <thread>
 #include <typeinfo>
-#include <omp.h>
 #include <algorithm>
 #include "core/FilteredCollisionDispatcher.h"
 #include "core/GraphicalSimulationApp.h"
@@ -53,6 +52,8 @@
 #include "utils/SystemUtil.hpp"
 #include "utils/UnitSystem.h"
 #include "utils/RayTest.hpp"
+#include "utils/TickProfiler.h"
+#include "utils/TaskScheduler.h"
 #include "entities/Entity.h"
 //#include "entities/CableEntity.h"
 #include "entities/FeatherstoneEntity.h"
@@ -83,6 +84,7 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
 {
     //Initialize simulation world
     realtimeFactor = Scalar(1);
+    freeRunning = false;
     cpuUsage = Scalar(0);
     solver = st;
     collisionFilter = cft;
@@ -91,9 +93,12 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     linSleepThreshold = Scalar(0);
     angSleepThreshold = Scalar(0);
     fdCounter = 0;
+    hydroAdaptive = false;
+    randomSeed = 0;
     currentTime = 0;
     simulationTime = 0;
     mlcpFallbacks = 0;
+    sensorScheduleValid = false;
     dynamicsWorld = nullptr;
     mbSolver = nullptr;
     sbSolver = nullptr;
@@ -227,7 +232,7 @@ void SimulationManager::EnableOcean(Scalar waves, Fluid f)
     
     bool hasGraphics = SimulationApp::getApp()->hasGraphics();
 
-    ocean = new Ocean("Ocean", hasGraphics ? waves : 0.0, f);
+    ocean = new Ocean("Ocean", waves, f);
     ocean->AddToSimulation(this);
     
     if(hasGraphics)
@@ -258,13 +263,20 @@ void SimulationManager::EnableAtmosphere()
 void SimulationManager::AddSensor(Sensor* sens)
 {
     if(sens != nullptr)
+    {
+        sens->setRandomSeed(DeriveSeed(sensors.size()));
         sensors.push_back(sens);
+        sensorScheduleValid = false;
+    }
 }
 
 void SimulationManager::AddComm(Comm* comm)
 {
     if(comm != nullptr)
+    {
+        comm->setRandomSeed(DeriveSeed(comms.size(), true));
         comms.push_back(comm);
+    }
 }
 
 void SimulationManager::AddJoint(Joint* jnt)
@@ -301,20 +313,58 @@ void SimulationManager::AddContact(Contact* cnt)
     if(cnt != nullptr)
     {
         contacts.push_back(cnt);
+        contactIndex.emplace(MakeEntityPair(cnt->getEntityA(), cnt->getEntityB()), cnt); //First contact defined for a pair is used
         EnableCollision(cnt->getEntityA(), cnt->getEntityB());
     }
 }
 
+void SimulationManager::CollectBodiesInFluid(ForcefieldEntity* fluid, std::vector<std::pair<SolidEntity*, bool>>& bodies)
+{
+    bodies.clear();
+    btBroadphasePairArray& pairArray = fluid->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
+    
+    for(int h=0; h<pairArray.size(); ++h)
+    {
+        const btBroadphasePair& pair = pairArray[h];
+        btBroadphasePair* colPair = dynamicsWorld->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+        if (!colPair)
+            continue;
+            
+        btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
+        btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+        Entity* ent = nullptr;
+        
+        if(co1 == fluid->getGhost())
+            ent = ForcefieldEntity::getDynamicEntity(co2);
+        else if(co2 == fluid->getGhost())
+            ent = ForcefieldEntity::getDynamicEntity(co1);
+        
+        if(ent != nullptr && ent->getType() == EntityType::SOLID)
+            bodies.push_back(std::make_pair((SolidEntity*)ent, false));
+    }
+}
+
+EntityPair SimulationManager::MakeEntityPair(const Entity* entA, const Entity* entB)
+{
+    return std::less<const Entity*>()(entA, entB) ? EntityPair(entA, entB) : EntityPair(entB, entA);
+}
+
 int SimulationManager::CheckCollision(const Entity *entA, const Entity *entB)
 {
-    for(size_t i = 0; i < collisions.size(); ++i)
+    auto it = collisionIndex.find(MakeEntityPair(entA, entB));
+    return it != collisionIndex.end() ? (int)it->second : -1;
+}
+
+void SimulationManager::RemoveCollision(size_t index)
+{
+    //Swap with the last rule to keep the indices of the remaining rules valid
+    collisionIndex.erase(MakeEntityPair(collisions[index].A, collisions[index].B));
+    if(index != collisions.size()-1)
     {
-        if((collisions[i].A == entA && collisions[i].B == entB) 
-            || (collisions[i].B == entA && collisions[i].A == entB))
-                return (int)i;
+        collisions[index] = collisions.back();
+        collisionIndex[MakeEntityPair(collisions[index].A, collisions[index].B)] = index;
     }
-    
-    return -1;
+    collisions.pop_back();
 }
 
 void SimulationManager::EnableCollision(const Entity* entA, const Entity* entB)
@@ -326,11 +376,12 @@ void SimulationManager::EnableCollision(const Entity* entA, const Entity* entB)
         Collision c;
         c.A = const_cast<Entity*>(entA);
         c.B = const_cast<Entity*>(entB);
+        collisionIndex[MakeEntityPair(entA, entB)] = collisions.size();
         collisions.push_back(c);
     }
     else if(collisionFilter == CollisionFilteringType::COLLISION_EXCLUSIVE && colId > -1)
     {
-        collisions.erase(collisions.begin() + colId);
+        RemoveCollision((size_t)colId);
     }
 }
     
@@ -342,33 +393,21 @@ void SimulationManager::DisableCollision(const Entity* entA, const Entity* entB)
         Collision c;
         c.A = const_cast<Entity*>(entA);
         c.B = const_cast<Entity*>(entB);
+        collisionIndex[MakeEntityPair(entA, entB)] = collisions.size();
         collisions.push_back(c);
         cInfo("Disabling collisions between '%s' and '%s'.", entA->getName().c_str(), entB->getName().c_str());
     }
     else if(collisionFilter == CollisionFilteringType::COLLISION_INCLUSIVE && colId > -1)
     {
-        collisions.erase(collisions.begin() + colId);
+        RemoveCollision((size_t)colId);
         cInfo("Disabling collisions between '%s' and '%s'.", entA->getName().c_str(), entB->getName().c_str());
     }
 }
 
 Contact* SimulationManager::getContact(Entity* entA, Entity* entB)
 {
-    for(size_t i = 0; i < contacts.size(); ++i)
-    {
-        if(contacts[i]->getEntityA() == entA)
-        {
-            if(contacts[i]->getEntityB() == entB)
-                return contacts[i];
-        }
-        else if(contacts[i]->getEntityB() == entA)
-        {
-            if(contacts[i]->getEntityA() == entB)
-                return contacts[i];
-        }
-    }
-    
-    return nullptr;
+    auto it = contactIndex.find(MakeEntityPair(entA, entB));
+    return it != contactIndex.end() ? it->second : nullptr;
 }
 
 Contact* SimulationManager::getContact(unsigned int index)
@@ -585,6 +624,69 @@ void SimulationManager::setRealtimeFactor(Scalar f)
     SDL_UnlockMutex(simInfoMutex);
 }
 
+void SimulationManager::setFreeRunning(bool enabled)
+{
+    SDL_LockMutex(simSettingsMutex);
+    freeRunning = enabled;
+    currentTime = 0; //Resynchronize with the simulation clock when going back to paced mode
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::isFreeRunning() const
+{
+    return freeRunning;
+}
+
+void SimulationManager::setAdaptiveHydrodynamics(bool enabled)
+{
+    SDL_LockMutex(simSettingsMutex);
+    hydroAdaptive = enabled;
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+void SimulationManager::setAdaptiveHydrodynamicsSettings(const AdaptiveHydrodynamicsSettings& settings)
+{
+    SDL_LockMutex(simSettingsMutex);
+    hydroAdaptiveSettings = settings;
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::isAdaptiveHydrodynamics() const
+{
+    return hydroAdaptive;
+}
+
+AdaptiveHydrodynamicsSettings SimulationManager::getAdaptiveHydrodynamicsSettings() const
+{
+    return hydroAdaptiveSettings;
+}
+
+void SimulationManager::setRandomSeed(unsigned int seed)
+{
+    SDL_LockMutex(simSettingsMutex);
+    randomSeed = seed;
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->setRandomSeed(DeriveSeed(i));
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->setRandomSeed(DeriveSeed(i, true));
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+unsigned int SimulationManager::getRandomSeed() const
+{
+    return randomSeed;
+}
+
+unsigned int SimulationManager::DeriveSeed(size_t index, bool comm) const
+{
+    //SplitMix64 finalizer, to decorrelate the generators of neighbouring objects
+    uint64_t z = ((uint64_t)randomSeed << 32) + ((uint64_t)comm << 31) + (uint64_t)index + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+    return (unsigned int)(z ^ (z >> 32));
+}
+
 Scalar SimulationManager::getStepsPerSecond() const
 {
     return sps;
@@ -717,11 +819,11 @@ void SimulationManager::InitializeSolver()
     switch(collisionFilter)
     {
         case CollisionFilteringType::COLLISION_INCLUSIVE:
-            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, true);
+            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, this, true);
             break;
 
         case CollisionFilteringType::COLLISION_EXCLUSIVE:
-            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, false);
+            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, this, false);
             break;
     }
     //dwDispatcher = new btCollisionDispatcher(dwCollisionConfig);
@@ -910,10 +1012,19 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<contacts.size(); ++i)
         delete contacts[i];
     contacts.clear();
+    contactIndex.clear();
+    
+    collisions.clear();
+    collisionIndex.clear();
     
     for(size_t i=0; i<sensors.size(); ++i)
         delete sensors[i];
     sensors.clear();
+    sensorOrder.clear();
+    sensorStageEnds.clear();
+    sensorNames.clear();
+    sensorTimes.clear();
+    sensorScheduleValid = false;
     
     for(size_t i=0; i<comms.size(); ++i)
         delete comms[i];
@@ -955,6 +1066,7 @@ bool SimulationManager::StartSimulation()
     //Reset sensors
     for(unsigned int i = 0; i < sensors.size(); i++)
         sensors[i]->Reset();
+    sensorScheduleValid = false; //Sensor connections may have changed
 
     perfMon.SimulationStarted();
     
@@ -1013,8 +1125,11 @@ bool SimulationManager::SolveICProblem()
     
     double solveTime = (GetTimeInMicroseconds() - icTime)/(double)1e6;
     
-    //Synchronize body transforms
+    //Synchronize body transforms and link velocities
     dynamicsWorld->synchronizeMotionStates();
+    for(size_t i = 0; i < entities.size(); ++i)
+        if(entities[i]->getType() == EntityType::FEATHERSTONE)
+            ((FeatherstoneEntity*)entities[i])->UpdateKinematics();
     simulationTime = Scalar(0.);
 
     //Solving time
@@ -1035,6 +1150,13 @@ void SimulationManager::AdvanceSimulation()
     if(!icProblemSolved)
         return;
 
+    //Run as fast as possible, one fixed step at a time
+    if(freeRunning)
+    {
+        StepSimulation(1);
+        return;
+    }
+
     //Calculate eleapsed time
     uint64_t deltaTime;
 
@@ -1060,14 +1182,124 @@ void SimulationManager::AdvanceSimulation()
     //Step simulation
     SDL_LockMutex(simSettingsMutex);
     perfMon.PhysicsStarted();
-    dynamicsWorld->stepSimulation((Scalar)deltaTime/Scalar(1000000.0), 1000000, (Scalar)ssus/Scalar(1000000.0));
+    {
+        ProfileScope scope("Physics");
+        dynamicsWorld->stepSimulation((Scalar)deltaTime/Scalar(1000000.0), 1000000, (Scalar)ssus/Scalar(1000000.0));
+    }
+    perfMon.PhysicsFinished();
+    SDL_UnlockMutex(simSettingsMutex);
+
+    UpdateSolverStatistics(deltaTime);
+}
+
+void SimulationManager::StepSimulation(unsigned int steps)
+{
+    //Check if initial conditions solved
+    if(!icProblemSolved || steps == 0)
+        return;
+
+    //Step simulation with a fixed time step (no clock reads, no sleeping)
+    SDL_LockMutex(simSettingsMutex);
+    Scalar dt = (Scalar)ssus/Scalar(1000000.0);
+    perfMon.PhysicsStarted();
+    for(unsigned int i=0; i<steps; ++i)
+    {
+        ProfileScope scope("Physics");
+        dynamicsWorld->stepSimulation(dt, 1, dt);
+    }
     perfMon.PhysicsFinished();
+    uint64_t deltaTime = ssus * steps;
+    currentTime = 0; //Paced stepping has to resynchronize with the clock
     SDL_UnlockMutex(simSettingsMutex);
 
+    UpdateSolverStatistics(deltaTime);
+}
+
+void SimulationManager::SaveSnapshot(SimulationSnapshot& snapshot)
+{
+    SDL_LockMutex(simSettingsMutex);
+    
+    snapshot.numOfEntities = entities.size();
+    snapshot.numOfActuators = actuators.size();
+    snapshot.numOfSensors = sensors.size();
+    snapshot.numOfComms = comms.size();
+    
+    StateBuffer& state = snapshot.state;
+    state.Clear();
+    state.Write(simulationTime);
+    state.Write(fdCounter);
+    state.Write(mlcpFallbacks);
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->SaveState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->SaveState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->SaveState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->SaveState(state);
+    
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::RestoreSnapshot(const SimulationSnapshot& snapshot)
+{
+    SDL_LockMutex(simSettingsMutex);
+    
+    if(snapshot.numOfEntities != entities.size() || snapshot.numOfActuators != actuators.size()
+       || snapshot.numOfSensors != sensors.size() || snapshot.numOfComms != comms.size())
+    {
+        SDL_UnlockMutex(simSettingsMutex);
+        cError("Snapshot does not match the simulation world!");
+        return false;
+    }
+    
+    StateReader state(snapshot.state);
+    state.Read(simulationTime);
+    state.Read(fdCounter);
+    state.Read(mlcpFallbacks);
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->RestoreState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->RestoreState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->RestoreState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->RestoreState(state);
+    
+    //Contact points of the previous state are not valid anymore
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    for(int i=0; i<dispatcher->getNumManifolds(); ++i)
+        dispatcher->getManifoldByIndexInternal(i)->clearManifold();
+    
+    //Update overlapping pairs, used before the next step to find bodies in fluids
+    dynamicsWorld->updateAabbs();
+    dynamicsWorld->computeOverlappingPairs();
+    
+    for(size_t i=0; i<contacts.size(); ++i)
+        contacts[i]->ClearHistory();
+    
+    currentTime = 0; //Paced stepping has to resynchronize with the clock
+    SDL_UnlockMutex(simSettingsMutex);
+    
+    if(!state.isValid() || !state.isAtEnd())
+    {
+        cError("Snapshot is corrupted! Simulation state may be inconsistent.");
+        return false;
+    }
+    return true;
+}
+
+void SimulationManager::UpdateSolverStatistics(uint64_t deltaTime)
+{
     SDL_LockMutex(simInfoMutex);
-    Scalar cpuUsageNow = (Scalar)perfMon.getPhysicsTime()/(Scalar)deltaTime * Scalar(100);
-    Scalar filter(0.001);
-    cpuUsage = filter * cpuUsageNow + (Scalar(1)-filter) * cpuUsage;   
+    if(deltaTime > 0)
+    {
+        Scalar cpuUsageNow = (Scalar)perfMon.getPhysicsTime()/(Scalar)deltaTime * Scalar(100);
+        Scalar filter(0.001);
+        cpuUsage = filter * cpuUsageNow + (Scalar(1)-filter) * cpuUsage;
+    }
     
     //Inform about MLCP failures
     if(solver != SolverType::SOLVER_SI)
@@ -1087,6 +1319,86 @@ void SimulationManager::AdvanceSimulation()
     SDL_UnlockMutex(simInfoMutex);
 }
 
+void SimulationManager::UpdateSensorSchedule()
+{
+    //Find the stage of each sensor, so that it is updated after the sensors it depends on
+    std::unordered_map<Sensor*, size_t> stage;
+    for(size_t i=0; i<sensors.size(); ++i)
+        stage[sensors[i]] = sensors[i]->getType() == SensorType::VISION ? 0 : 1;
+    
+    std::vector<std::vector<Sensor*>> deps(sensors.size());
+    for(size_t i=0; i<sensors.size(); ++i)
+        if(sensors[i]->getType() != SensorType::VISION)
+            deps[i] = sensors[i]->getDependencies();
+    
+    bool changed = true;
+    for(size_t iter=0; changed && iter<=sensors.size(); ++iter)
+    {
+        changed = false;
+        for(size_t i=0; i<sensors.size(); ++i)
+            for(size_t h=0; h<deps[i].size(); ++h)
+            {
+                auto it = stage.find(deps[i][h]);
+                if(it != stage.end() && stage[sensors[i]] < it->second + 1)
+                {
+                    stage[sensors[i]] = it->second + 1;
+                    changed = true;
+                }
+            }
+    }
+    if(changed)
+        cWarning("Cyclic dependency between sensors detected! Update order of the affected sensors is undefined.");
+    
+    //Stage 0 -> vision sensors, handing data over to the rendering thread (serial)
+    //Stage >0 -> independent sensors (parallel)
+    sensorOrder = sensors;
+    std::stable_sort(sensorOrder.begin(), sensorOrder.end(), [&stage](Sensor* a, Sensor* b) { return stage[a] < stage[b]; });
+    sensorStageEnds.clear();
+    sensorNames.resize(sensorOrder.size());
+    sensorTimes.assign(sensorOrder.size(), 0.0);
+    for(size_t i=0; i<sensorOrder.size(); ++i)
+    {
+        sensorNames[i] = sensorOrder[i]->getName();
+        size_t s = stage[sensorOrder[i]];
+        while(sensorStageEnds.size() <= s)
+            sensorStageEnds.push_back((int)i);
+    }
+    sensorStageEnds.push_back((int)sensorOrder.size());
+    sensorStageEnds.erase(sensorStageEnds.begin()); //Entry k -> end of stage k
+    sensorScheduleValid = true;
+}
+
+void SimulationManager::UpdateSensors(Scalar dt)
+{
+    if(!sensorScheduleValid)
+        UpdateSensorSchedule();
+    
+    ProfileScope scope("Sensors", "Measurements");
+    perfMon.SensorsStarted();
+    int begin = 0;
+    for(size_t s=0; s<sensorStageEnds.size(); ++s)
+    {
+        int end = sensorStageEnds[s];
+        auto updateSensor = [this, dt](size_t i)
+        {
+            ProfileScope sensorScope(sensorNames[i], "Sensors");
+            auto start = std::chrono::high_resolution_clock::now();
+            sensorOrder[i]->Update(dt);
+            auto stop = std::chrono::high_resolution_clock::now();
+            sensorTimes[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()/1000.0;
+        };
+        
+        if(s > 0)
+            TaskScheduler::ParallelFor(begin, end, updateSensor);
+        else
+            for(int i=begin; i<end; ++i)
+                updateSensor(i);
+        begin = end;
+    }
+    perfMon.SensorsFinished();
+    perfMon.SensorsUpdated(sensorNames, sensorTimes);
+}
+
 void SimulationManager::SimulationStepCompleted(Scalar timeStep)
 {
 #ifdef DEBUG
@@ -1097,6 +1409,8 @@ void SimulationManager::SimulationStepCompleted(Scalar timeStep)
 
 void SimulationManager::UpdateDrawingQueue()
 {
+    ProfileScope scope("Drawing queue");
+    
     //Build new drawing queue
     OpenGLPipeline* glPipeline = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline();
  
@@ -1119,28 +1433,16 @@ void SimulationManager::UpdateDrawingQueue()
         
     //Actuators
     for(size_t i=0; i<actuators.size(); ++i)
-    {
         glPipeline->AddToDrawingQueue(actuators[i]->Render());
-        if(actuators[i]->getType() == ActuatorType::LIGHT)
-            ((Light*)actuators[i])->UpdateTransform();
-    }
     
     //Sensors
     for(size_t i=0; i<sensors.size(); ++i)
-    {
         glPipeline->AddToDrawingQueue(sensors[i]->Render());
-        if(sensors[i]->getType() == SensorType::VISION)
-            ((VisionSensor*)sensors[i])->UpdateTransform();
-    }
     
     //Comms
     for(size_t i=0; i<comms.size(); ++i)
         glPipeline->AddToDrawingQueue(comms[i]->Render());
     
-    //Trackball
-    if(trackball != nullptr)
-        trackball->UpdateCenterPos();
-    
     //Contacts
     for(size_t i=0; i<contacts.size(); ++i)
         glPipeline->AddToDrawingQueue(contacts[i]->Render());
@@ -1148,6 +1450,20 @@ void SimulationManager::UpdateDrawingQueue()
     //Ocean currents
     if(ocean != nullptr)
         glPipeline->AddToDrawingQueue(ocean->Render(actuators));
+    
+    //Pass transforms of lights, views and trackball together with the drawing queue
+    for(size_t i=0; i<actuators.size(); ++i)
+        if(actuators[i]->getType() == ActuatorType::LIGHT)
+            ((Light*)actuators[i])->UpdateTransform();
+    
+    for(size_t i=0; i<sensors.size(); ++i)
+        if(sensors[i]->getType() == SensorType::VISION)
+            ((VisionSensor*)sensors[i])->UpdateTransform();
+    
+    if(trackball != nullptr)
+        trackball->UpdateCenterPos();
+    
+    glPipeline->PublishDrawingQueue(this);
 }
 
 std::pair<Entity*, int>  SimulationManager::PickEntity(Vector3 eye, Vector3 ray)
@@ -1168,6 +1484,50 @@ std::pair<Entity*, int>  SimulationManager::PickEntity(Vector3 eye, Vector3 ray)
         return std::make_pair(nullptr, -1);
 }
 
+void SimulationManager::RayTest(const RayBatch& rays, RayHits& hits, int filterMask) const
+{
+    int n = (int)rays.size();
+    hits.fraction.resize(n);
+    hits.normal.resize(n);
+    hits.entity.resize(n);
+    
+    btDbvtBroadphase* dbvt = dynamic_cast<btDbvtBroadphase*>(dwBroadphase);
+    
+    auto castRay = [&](size_t i)
+    {
+        btCollisionWorld::ClosestRayResultCallback closest(rays.from[i], rays.to[i]);
+        closest.m_collisionFilterGroup = MASK_DYNAMIC;
+        closest.m_collisionFilterMask = filterMask;
+        
+        if(dbvt != nullptr)
+        {
+            static thread_local btAlignedObjectArray<const btDbvtNode*> stack; //Reused between rays
+            DbvtRayTest(dbvt, rays.from[i], rays.to[i], closest, stack);
+        }
+        else
+            dynamicsWorld->rayTest(rays.from[i], rays.to[i], closest);
+        
+        if(closest.hasHit())
+        {
+            hits.fraction[i] = closest.m_closestHitFraction;
+            hits.normal[i] = closest.m_hitNormalWorld;
+            hits.entity[i] = (Entity*)closest.m_collisionObject->getUserPointer();
+        }
+        else
+        {
+            hits.fraction[i] = Scalar(1);
+            hits.normal[i] = V0();
+            hits.entity[i] = nullptr;
+        }
+    };
+    
+    if(dbvt != nullptr && n > 16)
+        TaskScheduler::ParallelFor(0, n, castRay, 8);
+    else
+        for(int i=0; i<n; ++i)
+            castRay(i);
+}
+
 void SimulationManager::RenderBulletDebug()
 {
     dynamicsWorld->debugDrawWorld();
@@ -1347,6 +1707,11 @@ void SimulationManager::SolveICTickCallback(btDynamicsWorld* world, Scalar timeS
     //Clear all forces to ensure that no summing occurs
     researchWorld->clearForces(); //Includes clearing of multibody forces!
     
+    //Update cached link velocities
+    for(size_t i = 0; i < simManager->entities.size(); ++i)
+        if(simManager->entities[i]->getType() == EntityType::FEATHERSTONE)
+            ((FeatherstoneEntity*)simManager->entities[i])->UpdateKinematics();
+    
     //Solve for objects settling
     bool objectsSettled = true;
     
@@ -1446,142 +1811,182 @@ void SimulationManager::SolveICTickCallback(btDynamicsWorld* world, Scalar timeS
 //Used to apply and accumulate forces
 void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar timeStep)
 {
+    ProfileScope scope("Forces");
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
     btMultiBodyDynamicsWorld* mbDynamicsWorld = (btMultiBodyDynamicsWorld*)world;
         
     //Clear all forces to ensure that no summing occurs
     mbDynamicsWorld->clearForces(); //Includes clearing of multibody forces!
-        
+    
+    //Geometry-based forces
+    bool recompute = simManager->fdCounter % simManager->fdPrescaler == 0;
+    ++simManager->fdCounter;
+    
+    /* The forces are computed by a graph of tasks. Actuators, joint damping and gravity write directly
+       to the force accumulators of the bodies, so they run one after another. Geometry-based forces are computed
+       in parallel with them, each body writing only to its own force slots, and then applied to Bullet serially.
+       Every body is computed by a single thread and its forces are summed in a fixed order,
+       so the result does not depend on the number of threads. */
+    TaskGraph graph;
+    
     //loop through all actuators -> apply forces to bodies (free and connected by joints)
-    for(size_t i = 0; i < simManager->actuators.size(); ++i)
-        simManager->actuators[i]->Update(timeStep);
+    size_t actuatorsTask = graph.AddTask([simManager, timeStep]()
+    {
+        ProfileScope actuatorsScope("Actuators", "Forces");
+        for(size_t i = 0; i < simManager->actuators.size(); ++i)
+            simManager->actuators[i]->Update(timeStep);
+    });
     
     //loop through all joints -> apply damping forces to bodies connected by joints
-    for(size_t i = 0; i < simManager->joints.size(); ++i)
-        simManager->joints[i]->ApplyDamping();
+    size_t dampingTask = graph.AddTask([simManager]()
+    {
+        ProfileScope dampingScope("Joint damping", "Forces");
+        for(size_t i = 0; i < simManager->joints.size(); ++i)
+            simManager->joints[i]->ApplyDamping();
+    }, {actuatorsTask});
     
     //loop through all entities that may need special actions
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
+    size_t gravityTask = graph.AddTask([simManager, mbDynamicsWorld]()
     {
-        Entity* ent = simManager->entities[i];
+        ProfileScope gravityScope("Gravity", "Forces");
+        Vector3 g = mbDynamicsWorld->getGravity();
         
-        if(ent->getType() == EntityType::SOLID)
-        {
-            SolidEntity* solid = (SolidEntity*)ent;
-            solid->ApplyGravity(mbDynamicsWorld->getGravity());
-        }
-        else if(ent->getType() == EntityType::FEATHERSTONE)
+        TaskScheduler::ParallelFor(0, simManager->entities.size(), [simManager, mbDynamicsWorld, &g](size_t i)
         {
-            FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
-            multibody->ApplyGravity(mbDynamicsWorld->getGravity());
-            multibody->ApplyDamping();
-        }
-        /*else if(ent->getType() == EntityType::CABLE)
-        {
-            CableEntity* cable = (CableEntity*)ent;
-            cable->ApplyGravity(mbDynamicsWorld->getGravity());
-        }*/
-        else if(ent->getType() == EntityType::FORCEFIELD)
-        {
-            ForcefieldEntity* ff = (ForcefieldEntity*)ent;
-            if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
-            {				
-                Trigger* trigger = (Trigger*)ff;
-                trigger->Clear();
-                btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-                int numPairs = pairArray.size();
-                    
-                for(int h = 0; h < numPairs; ++h)
+            Entity* ent = simManager->entities[i];
+            
+            if(ent->getType() == EntityType::SOLID)
+            {
+                SolidEntity* solid = (SolidEntity*)ent;
+                solid->ApplyGravity(g);
+            }
+            else if(ent->getType() == EntityType::FEATHERSTONE)
+            {
+                FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
+                multibody->ApplyGravity(g);
+                multibody->ApplyDamping();
+            }
+            /*else if(ent->getType() == EntityType::CABLE)
+            {
+                CableEntity* cable = (CableEntity*)ent;
+                cable->ApplyGravity(g);
+            }*/
+            else if(ent->getType() == EntityType::FORCEFIELD)
+            {
+                ForcefieldEntity* ff = (ForcefieldEntity*)ent;
+                if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
                 {
-                    const btBroadphasePair& pair = pairArray[h];
-                    btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                    if(!colPair)
-                        continue;
+                    Trigger* trigger = (Trigger*)ff;
+                    trigger->Clear();
+                    btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
+                    int numPairs = pairArray.size();
                     
-                    btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                    btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                    if(co1 == trigger->getGhost())
-                        trigger->Activate(co2);
-                    else if(co2 == trigger->getGhost())
-                        trigger->Activate(co1);
+                    for(int h = 0; h < numPairs; ++h)
+                    {
+                        const btBroadphasePair& pair = pairArray[h];
+                        btBroadphasePair* colPair = mbDynamicsWorld->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+                        if(!colPair)
+                            continue;
+                        
+                        btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
+                        btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+                        
+                        if(co1 == trigger->getGhost())
+                            trigger->Activate(co2);
+                        else if(co2 == trigger->getGhost())
+                            trigger->Activate(co1);
+                    }
                 }
             }
-        }
-    }
+        }, 4);
+    }, {dampingTask});
     
-    //Geometry-based forces
-    bool recompute = simManager->fdCounter % simManager->fdPrescaler == 0;
-    ++simManager->fdCounter;
+    std::vector<size_t> forceTasks = {gravityTask};
     
     //Aerodynamic forces
     if(simManager->atmosphere != nullptr)
     {
-        btBroadphasePairArray& pairArray = simManager->atmosphere->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
-        
-        if(numPairs > 0)
+        forceTasks.push_back(graph.AddTask([simManager, recompute]()
         {
-            #pragma omp parallel for schedule(dynamic)
-            for(int h=0; h<numPairs; ++h)
-            {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                if(co1 == simManager->atmosphere->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co1, recompute);
-            }
-        }
+            ProfileScope aeroScope("Aerodynamics", "Forces");
+            std::vector<std::pair<SolidEntity*, bool>>& bodies = simManager->aeroBodies;
+            simManager->CollectBodiesInFluid(simManager->atmosphere, bodies);
+            
+            if(recompute)
+                TaskScheduler::ParallelFor(0, bodies.size(), [simManager, &bodies](size_t i)
+                {
+                    simManager->atmosphere->ComputeFluidForces(bodies[i].first);
+                });
+        }));
     }
     
-    //Hydrodynamic forces
+    //Hydrodynamic forces (actuators read the wave field, which is updated here)
     if(simManager->ocean != nullptr)
     {
-        if(recompute) SDL_LockMutex(simManager->simHydroMutex);
-        simManager->perfMon.HydrodynamicsStarted();
-        
-        btBroadphasePairArray& pairArray = simManager->ocean->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
-        
-        if(numPairs > 0)
+        forceTasks.push_back(graph.AddTask([simManager, recompute]()
         {
-            #pragma omp parallel for schedule(dynamic)
-            for(int h=0; h<numPairs; ++h)
+            simManager->perfMon.HydrodynamicsStarted();
+            ProfileScope hydroScope("Hydrodynamics", "Forces");
+            
+            //Waves are advanced every step (actuators and sensors sample the surface even if no forces are recomputed)
+            SDL_LockMutex(simManager->simHydroMutex);
+            simManager->ocean->UpdateWaves(simManager->simulationTime);
+            SDL_UnlockMutex(simManager->simHydroMutex);
+            
+            //Collect bodies in the water and decide which need recomputation of forces
+            std::vector<std::pair<SolidEntity*, bool>>& bodies = simManager->hydroBodies;
+            simManager->CollectBodiesInFluid(simManager->ocean, bodies);
+            size_t numRecomputed = 0;
+            
+            for(size_t i=0; i<bodies.size(); ++i)
             {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+                bodies[i].second = simManager->hydroAdaptive ? bodies[i].first->UpdateHydrodynamicsSchedule(simManager->ocean, simManager->fdPrescaler, simManager->hydroAdaptiveSettings) : recompute;
+                if(bodies[i].second) ++numRecomputed;
+            }
+            
+            if(numRecomputed > 0)
+            {
+                SDL_LockMutex(simManager->simHydroMutex);
+                TaskScheduler::ParallelFor(0, bodies.size(), [simManager, &bodies](size_t i)
+                {
+                    if(bodies[i].second)
+                        simManager->ocean->ComputeFluidForces(bodies[i].first);
+                });
                 
-                if(co1 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co1, recompute);
+                SDL_UnlockMutex(simManager->simHydroMutex);
             }
-        }
-        
-        simManager->perfMon.HydrodynamicsFinished();
-        if(recompute) SDL_UnlockMutex(simManager->simHydroMutex);
+            
+            if(!bodies.empty())
+                TickProfiler::Counter("Hydrodynamics skip rate", 1.0 - (double)numRecomputed/(double)bodies.size());
+            simManager->perfMon.HydrodynamicsFinished();
+        }, {actuatorsTask}));
     }
+    
+    //Apply geometry-based forces to Bullet
+    graph.AddTask([simManager]()
+    {
+        ProfileScope applyScope("Fluid forces", "Forces");
+        if(simManager->atmosphere != nullptr)
+            for(size_t i=0; i<simManager->aeroBodies.size(); ++i)
+                simManager->atmosphere->ApplyFluidForces(simManager->aeroBodies[i].first, false);
+        
+        if(simManager->ocean != nullptr)
+            for(size_t i=0; i<simManager->hydroBodies.size(); ++i)
+                simManager->ocean->ApplyFluidForces(simManager->hydroBodies[i].first, false);
+    }, forceTasks);
+    
+    graph.Run();
 }
 
 //Used to measure body motions and calculate controls
 void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scalar timeStep)
 {
+    ProfileScope scope("Measurements");
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
     
     //Update motion data
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
+    TickProfiler::Begin("Motion");
+    TaskScheduler::ParallelFor(0, simManager->entities.size(), [simManager, timeStep](size_t i)
     {
         Entity* ent = simManager->entities[i];
             
@@ -1593,6 +1998,7 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
         else if(ent->getType() == EntityType::FEATHERSTONE)
         {
             FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
+            fe->UpdateKinematics(); //Link velocities used until the next step
             fe->UpdateAcceleration(timeStep);
         }
         else if(ent->getType() == EntityType::ANIMATED)
@@ -1600,24 +2006,28 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
             AnimatedEntity* anim = (AnimatedEntity*)ent;
             anim->Update(timeStep);
         }
-    }
+    }, 4);
+    TickProfiler::End();
 
     //Special treatment of suction cup actuator
     for(size_t i = 0; i < simManager->actuators.size(); ++i)
         if(simManager->actuators[i]->getType() == ActuatorType::SUCTION_CUP)
             ((SuctionCup*)simManager->actuators[i])->Engage(simManager);
 
-    //Loop through all sensors -> update measurements
-    for(size_t i = 0; i < simManager->sensors.size(); ++i)
-        simManager->sensors[i]->Update(timeStep);
+    //Update all sensors -> measurements (independent sensors are updated in parallel)
+    simManager->UpdateSensors(timeStep);
         
-    //Loop through all comms -> update state and measurements
-    for(size_t i = 0; i < simManager->comms.size(); ++i)
-        simManager->comms[i]->Update(timeStep);
+    //Loop through all comms -> update state and measurements (comms interact with each other and can read sensors)
+    {
+        ProfileScope commsScope("Comms", "Measurements");
+        for(size_t i = 0; i < simManager->comms.size(); ++i)
+            simManager->comms[i]->Update(timeStep);
+    }
     
     //Loop through contact manifolds -> update contacts
-    if(simManager->getContact(0) != nullptr) // If at least one contact is defined
+    if(!simManager->contactIndex.empty()) // If at least one contact is defined
     {
+        ProfileScope contactScope("Contacts");
         int numManifolds = world->getDispatcher()->getNumManifolds();
         for(int i=0; i<numManifolds; ++i)
         {
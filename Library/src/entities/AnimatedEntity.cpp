@@ -29,6 +29,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -302,6 +303,50 @@ void AnimatedEntity::Update(Scalar dt)
     setLinearAcceleration(tr->getInterpolatedLinearAcceleration());
 }
 
+void AnimatedEntity::SaveState(StateBuffer& state) const
+{
+    if(rigidBody != nullptr)
+    {
+        Transform graphicsTrans;
+        rigidBody->getMotionState()->getWorldTransform(graphicsTrans);
+        state.Write(rigidBody->getWorldTransform());
+        state.Write(rigidBody->getInterpolationWorldTransform());
+        state.Write(graphicsTrans);
+        state.Write(rigidBody->getLinearVelocity());
+        state.Write(rigidBody->getAngularVelocity());
+    }
+    state.Write(linearAcc);
+    state.Write(angularAcc);
+    
+    if(tr != nullptr)
+        tr->SaveState(state);
+}
+
+void AnimatedEntity::RestoreState(StateReader& state)
+{
+    if(rigidBody != nullptr)
+    {
+        Transform trans, interpTrans, graphicsTrans;
+        Vector3 v, omega;
+        state.Read(trans);
+        state.Read(interpTrans);
+        state.Read(graphicsTrans);
+        state.Read(v);
+        state.Read(omega);
+        
+        rigidBody->setWorldTransform(trans);
+        rigidBody->setInterpolationWorldTransform(interpTrans);
+        rigidBody->getMotionState()->setWorldTransform(graphicsTrans);
+        rigidBody->setLinearVelocity(v);
+        rigidBody->setAngularVelocity(omega);
+    }
+    state.Read(linearAcc);
+    state.Read(angularAcc);
+    
+    if(tr != nullptr)
+        tr->RestoreState(state);
+}
+
 std::vector<Renderable> AnimatedEntity::Render()
 {
     std::vector<Renderable> items(0);
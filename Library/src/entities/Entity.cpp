@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLContent.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -58,5 +59,13 @@ std::string Entity::getName() const
 {
     return name;
 }
+
+void Entity::SaveState(StateBuffer& state) const
+{
+}
+
+void Entity::RestoreState(StateReader& state)
+{
+}
         
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/StaticEntity.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -151,6 +152,7 @@ void FeatherstoneEntity::Respawn(const Transform& origin)
     btAlignedObjectArray<Vector3> scratchM;
     multiBody->forwardKinematics(scratchQ, scratchM);
     multiBody->updateCollisionObjectWorldTransforms(scratchQ, scratchM);
+    UpdateKinematics();
 }
 
 void FeatherstoneEntity::setSelfCollision(bool enabled)
@@ -205,8 +207,9 @@ void FeatherstoneEntity::setJointIC(unsigned int index, Scalar position, Scalar
             break;
             
         default:
-            break;
+            return;
     }
+    UpdateKinematics();
 }
 
 void FeatherstoneEntity::setJointDamping(unsigned int index, Scalar constantFactor, Scalar viscousFactor)
@@ -696,6 +699,89 @@ void FeatherstoneEntity::UpdateAcceleration(Scalar dt)
         links[i].solid->UpdateAcceleration(dt);
 }
 
+void FeatherstoneEntity::UpdateKinematics()
+{
+    int numLinks = multiBody->getNumLinks();
+    linkOmega.resize(numLinks + 1);
+    linkVel.resize(numLinks + 1);
+    worldToLink.resize(numLinks + 1);
+    
+    //Velocities in the link frames (index 0 -> base), following the parent of each link
+    multiBody->compTreeLinkVelocities(&linkOmega[0], &linkVel[0]);
+    
+    //Orientations of the link frames, in the same order (parent always precedes child)
+    worldToLink[0] = multiBody->getWorldToBaseRot();
+    for(int i = 0; i < numLinks; ++i)
+        worldToLink[i + 1] = multiBody->getParentToLocalRot(i) * worldToLink[multiBody->getParent(i) + 1];
+    
+    for(size_t i = 0; i < links.size(); ++i)
+    {
+        SolidEntity* solid = links[i].solid;
+        if(solid->multibodyCollider == nullptr)
+            continue;
+        int id = solid->multibodyCollider->m_link + 1;
+        Quaternion linkToWorld = worldToLink[id].inverse();
+        solid->linkLinearVelocity = quatRotate(linkToWorld, linkVel[id]);
+        solid->linkAngularVelocity = quatRotate(linkToWorld, linkOmega[id]);
+    }
+}
+
+void FeatherstoneEntity::SaveState(StateBuffer& state) const
+{
+    state.Write(multiBody->getBaseWorldTransform());
+    state.Write(multiBody->getBaseVel());
+    state.Write(multiBody->getBaseOmega());
+    state.Write(multiBody->isAwake());
+    
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        state.WriteBytes(multiBody->getJointPosMultiDof(i), multiBody->getLink(i).m_posVarCount * sizeof(Scalar));
+        state.WriteBytes(multiBody->getJointVelMultiDof(i), multiBody->getLink(i).m_dofCount * sizeof(Scalar));
+    }
+    
+    for(size_t i=0; i<links.size(); ++i)
+        links[i].solid->SaveState(state);
+}
+
+void FeatherstoneEntity::RestoreState(StateReader& state)
+{
+    Transform baseTrans;
+    Vector3 baseVel, baseOmega;
+    bool awake;
+    state.Read(baseTrans);
+    state.Read(baseVel);
+    state.Read(baseOmega);
+    state.Read(awake);
+    
+    multiBody->setBaseWorldTransform(baseTrans);
+    multiBody->setBaseVel(baseVel);
+    multiBody->setBaseOmega(baseOmega);
+    if(awake)
+        multiBody->wakeUp();
+    else
+        multiBody->goToSleep();
+    
+    Scalar q[4]; //Maximum number of position variables (spherical joint -> quaternion)
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        state.ReadBytes(q, multiBody->getLink(i).m_posVarCount * sizeof(Scalar));
+        multiBody->setJointPosMultiDof(i, q);
+        state.ReadBytes(q, multiBody->getLink(i).m_dofCount * sizeof(Scalar));
+        multiBody->setJointVelMultiDof(i, q);
+    }
+    multiBody->clearForcesAndTorques();
+    
+    //Move link colliders
+    btAlignedObjectArray<Quaternion> scratchQ;
+    btAlignedObjectArray<Vector3> scratchM;
+    multiBody->forwardKinematics(scratchQ, scratchM);
+    multiBody->updateCollisionObjectWorldTransforms(scratchQ, scratchM);
+    
+    //Cached link velocities are part of the state
+    for(size_t i=0; i<links.size(); ++i)
+        links[i].solid->RestoreState(state);
+}
+
 std::vector<Renderable> FeatherstoneEntity::Render()
 {	
     std::vector<Renderable> items(0);
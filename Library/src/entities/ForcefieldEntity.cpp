@@ -27,6 +27,7 @@
 
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLContent.h"
+#include "BulletDynamics/Featherstone/btMultiBodyLinkCollider.h"
 
 namespace sf
 {
@@ -51,6 +52,19 @@ btPairCachingGhostObject* ForcefieldEntity::getGhost()
     return ghost;
 }
 
+Entity* ForcefieldEntity::getDynamicEntity(const btCollisionObject* co)
+{
+    const btRigidBody* rb = btRigidBody::upcast(co);
+    const btMultiBodyLinkCollider* mbl = btMultiBodyLinkCollider::upcast(co);
+    
+    if(rb != 0)
+        return rb->isStaticOrKinematicObject() ? nullptr : (Entity*)rb->getUserPointer();
+    else if(mbl != 0)
+        return mbl->isStaticOrKinematicObject() ? nullptr : (Entity*)mbl->getUserPointer();
+    else
+        return nullptr;
+}
+
 void ForcefieldEntity::AddToSimulation(SimulationManager* sm)
 {
     sm->getDynamicsWorld()->addCollisionObject(ghost, MASK_GHOST, MASK_DYNAMIC);
@@ -30,6 +30,8 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/GeometryFileUtil.h"
+#include "utils/StateBuffer.h"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
 #include <iostream>
@@ -38,6 +40,66 @@
 namespace sf
 {
 
+HydroMesh::HydroMesh(const Mesh* mesh) : aabbMin(0.f), aabbMax(0.f), nFaces(0)
+{
+    if(mesh == nullptr)
+        return;
+    
+    //Vertices
+    size_t nVertices = mesh->getNumOfVertices();
+    vx.resize(nVertices);
+    vy.resize(nVertices);
+    vz.resize(nVertices);
+    for(size_t i=0; i<nVertices; ++i)
+    {
+        glm::vec3 pos = mesh->getVertexPos(i);
+        vx[i] = pos.x;
+        vy[i] = pos.y;
+        vz[i] = pos.z;
+        aabbMin = i == 0 ? pos : glm::min(aabbMin, pos);
+        aabbMax = i == 0 ? pos : glm::max(aabbMax, pos);
+    }
+    
+    //Faces (rigid transformations preserve areas, so they are computed once)
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        glm::vec3 p1 = mesh->getVertexPos(i, 0);
+        glm::vec3 p2 = mesh->getVertexPos(i, 1);
+        glm::vec3 p3 = mesh->getVertexPos(i, 2);
+        glm::vec3 fn = glm::cross(p2-p1, p3-p1);
+        GLfloat len = glm::length2(fn);
+        if(len < 1e-12f) continue;
+        len = glm::sqrt(len);
+        glm::vec3 fn1 = fn/len;
+        glm::vec3 fc = (p1+p2+p3)/3.f;
+        
+        f0.push_back(mesh->faces[i].vertexID[0]);
+        f1.push_back(mesh->faces[i].vertexID[1]);
+        f2.push_back(mesh->faces[i].vertexID[2]);
+        cx.push_back(fc.x);
+        cy.push_back(fc.y);
+        cz.push_back(fc.z);
+        nx.push_back(fn1.x);
+        ny.push_back(fn1.y);
+        nz.push_back(fn1.z);
+        area.push_back(len/2.f);
+    }
+    nFaces = area.size();
+    
+    //Padding with zero area faces
+    size_t nPadded = (nFaces + laneWidth - 1)/laneWidth * laneWidth;
+    f0.resize(nPadded, 0);
+    f1.resize(nPadded, 0);
+    f2.resize(nPadded, 0);
+    cx.resize(nPadded, 0.f);
+    cy.resize(nPadded, 0.f);
+    cz.resize(nPadded, 0.f);
+    nx.resize(nPadded, 0.f);
+    ny.resize(nPadded, 0.f);
+    nz.resize(nPadded, 0.f);
+    area.resize(nPadded, 0.f);
+}
+
 SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::string material, std::string look, Scalar thickness) 
     : MovingEntity(uniqueName, material, look), phy(phy), thick(thickness)
 {
@@ -89,6 +151,11 @@ SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::s
     Tda.setZero();
     Swet = Scalar(0);
     Vsub = Scalar(0);
+    hydroPosition = BodyFluidPosition::OUTSIDE;
+    hydroSteps = 0;
+    hydroFlowV.setZero();
+    hydroOmega.setZero();
+    hydroComputed = false;
     lastV.setZero();
     lastOmega.setZero();
     linearAcc.setZero();
@@ -96,7 +163,12 @@ SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::s
     
     //Set pointers
     multibodyCollider = nullptr;
+    linkLinearVelocity.setZero();
+    linkAngularVelocity.setZero();
     phyMesh = nullptr;
+    hydroMesh = nullptr;
+    hydroMaxFaces = 0;
+    hydroMaxError = Scalar(0);
     graObjectId = -1;
     phyObjectId = -1;
     dm = DisplayMode::GRAPHICAL;
@@ -107,7 +179,9 @@ SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::s
 SolidEntity::~SolidEntity()
 {
     if(phyMesh != nullptr) 
-        delete phyMesh;
+        ReleaseMesh(phyMesh);
+    if(hydroMesh != nullptr)
+        delete hydroMesh;
 }
 
 EntityType SolidEntity::getType() const
@@ -451,44 +525,7 @@ Vector3 SolidEntity::getLinearVelocity() const
     }
     else if(multibodyCollider != nullptr)
     {
-        //Get multibody and link id
-        btMultiBody* multiBody = multibodyCollider->m_multiBody;
-        int index = multibodyCollider->m_link;
-        
-        //Start with base velocity
-        Vector3 linVelocity = multiBody->getBaseVel(); //Global
-        Vector3 angVelocity = multiBody->getBaseOmega(); //Global
-        
-        if(index >= 0) //If collider is not base
-        {
-            for(int i = 0; i <= index; ++i) //Accumulate velocity resulting from joints
-            {
-                //Add velocity resulting from rotation of previous links
-                linVelocity += angVelocity.cross(multiBody->localDirToWorld(i, multiBody->getRVector(i)));
-                
-                if(multiBody->getLink(i).m_jointType == btMultibodyLink::ePrismatic) //Just add linear velocity
-                {
-                    Vector3 axis = multiBody->getLink(i).getAxisBottom(0); //Local axis
-                    Vector3 vel = multiBody->getJointVel(i) * axis; //Local velocity
-                    Vector3 gvel = multiBody->localDirToWorld(i, vel); //Global velocity
-                    linVelocity += gvel;
-                }
-                else if(multiBody->getLink(i).m_jointType == btMultibodyLink::eRevolute) //Add linear velocity due to rotation
-                {
-                    //Vector3 axis = multiBody->getLink(i).getAxisBottom(0); //Local linear motion
-                    //Vector3 vel = multiBody->getJointVel(i) * axis; //Local velocity
-                    
-                    Vector3 axis = multiBody->getLink(i).getAxisTop(0); //Axis of joint
-                    Vector3 aVel = multiBody->getJointVel(i) * axis;
-                    Vector3 vel = aVel.cross(multiBody->getLink(i).m_dVector); //Local velocity
-                    Vector3 gvel = multiBody->localDirToWorld(i, vel); //Global linear velocity
-                    linVelocity += gvel;
-                    angVelocity += multiBody->localDirToWorld(i, aVel); //Global angular velocity
-                }
-            }
-        }
-        
-        return linVelocity;
+        return linkLinearVelocity; //Cached once per step for all links of the multibody
     }
     else
         return Vector3(0,0,0);
@@ -502,26 +539,7 @@ Vector3 SolidEntity::getAngularVelocity() const
     }
     else if(multibodyCollider != nullptr)
     {
-        //Get multibody and link id
-        btMultiBody* multiBody = multibodyCollider->m_multiBody;
-        int index = multibodyCollider->m_link;
-        
-        //Start with base velocity
-        Vector3 angVelocity = multiBody->getBaseOmega(); //Global
-        
-        if(index >= 0)
-        {
-            for(int i = 0; i <= index; ++i) //Accumulate velocity resulting from joints
-                if(multiBody->getLink(i).m_jointType == btMultibodyLink::eRevolute) //Only revolute joints can change angular velocity
-                {
-                    Vector3 axis = multiBody->getLink(i).getAxisTop(0); //Local axis
-                    Vector3 vel = multiBody->getJointVel(i) * axis; //Local velocity
-                    Vector3 gvel = multiBody->localDirToWorld(i, vel); //Global velocity
-                    angVelocity += gvel;
-                }
-        }
-        
-        return angVelocity;
+        return linkAngularVelocity; //Cached once per step for all links of the multibody
     }
     else
         return Vector3(0,0,0);
@@ -535,7 +553,7 @@ Vector3 SolidEntity::getLinearVelocityInLocalPoint(const Vector3& relPos) const
     }
     else if(multibodyCollider != nullptr)
     {
-        return getLinearVelocity() + getAngularVelocity().cross(relPos);
+        return linkLinearVelocity + linkAngularVelocity.cross(relPos);
     }
     else
         return Vector3(0,0,0);
@@ -654,6 +672,47 @@ const Mesh* SolidEntity::getPhysicsMesh()
     return phyMesh;
 }
 
+void SolidEntity::setHydrodynamicsMeshLOD(size_t maxFaces, Scalar maxError)
+{
+    hydroMaxFaces = maxFaces;
+    hydroMaxError = maxError > Scalar(0) ? maxError : Scalar(0);
+    if(hydroMesh != nullptr) //Body already built
+        BuildHydrodynamicsMesh();
+}
+
+void SolidEntity::BuildHydrodynamicsMesh()
+{
+    if(hydroMesh != nullptr)
+    {
+        delete hydroMesh;
+        hydroMesh = nullptr;
+    }
+    if(phyMesh == nullptr)
+        return;
+    
+    if(hydroMaxFaces > 0 || hydroMaxError > Scalar(0))
+    {
+        PlainMesh lod;
+        lod.faces = phyMesh->faces;
+        lod.vertices.resize(phyMesh->getNumOfVertices());
+        for(size_t i=0; i<lod.vertices.size(); ++i)
+            lod.vertices[i].pos = phyMesh->getVertexPos(i);
+        glm::vec3 aabbMin, aabbMax;
+        OpenGLContent::AABB(&lod, aabbMin, aabbMax);
+        OpenGLContent::WeldVertices(&lod, glm::length(aabbMax - aabbMin) * 1e-5f); //Vertices split by normals or UVs
+        OpenGLContent::Decimate(&lod, hydroMaxFaces, (GLfloat)hydroMaxError);
+        hydroMesh = new HydroMesh(&lod);
+        cInfo("Decimated hydrodynamics mesh of %s [faces: %lu -> %lu]", getName().c_str(), (unsigned long)phyMesh->faces.size(), (unsigned long)lod.faces.size());
+    }
+    else
+        hydroMesh = new HydroMesh(phyMesh);
+}
+
+const HydroMesh* SolidEntity::getHydroMesh()
+{
+    return hydroMesh;
+}
+
 std::vector<Vector3>* SolidEntity::getMeshVertices() const
 {
     std::vector<Vector3>* vertices = new std::vector<Vector3>(0);
@@ -1005,7 +1064,12 @@ void SolidEntity::ComputeEllipsoidalApprox()
     cInfo("Ellipsoid axis: %1.3lf %1.3lf %1.3lf", d.x(), d.y(), d.z());
     cInfo("Ellipsoid core points: %d", x0.size());
 #endif
-    
+    delete x;
+    SetEllipsoidalApprox(d);
+}
+
+void SolidEntity::SetEllipsoidalApprox(const Vector3& d)
+{
     fdApproxType =  GeometryApproxType::ELLIPSOID;
     fdApproxParams.resize(3);
     fdApproxParams[0] = d.getX();
@@ -1042,7 +1106,6 @@ void SolidEntity::ComputeEllipsoidalApprox()
 #ifdef DEBUG
     cInfo("--------------------------------------------------------------------");
 #endif
-    delete x;
 }
 
 Scalar SolidEntity::LambKFactor(Scalar r1, Scalar r2)
@@ -1111,6 +1174,9 @@ void SolidEntity::BuildRigidBody()
         if(contactK > Scalar(0))
             rigidBody->setContactStiffnessAndDamping(contactK, contactD);
 
+        //Hydrodynamics
+        BuildHydrodynamicsMesh();
+        
         cInfo("Built rigid body %s [mass: %1.3lf; inertia: %1.3lf, %1.3lf, %1.3lf; volume: %1.1lf]", getName().c_str(), mass, Ipri.x(), Ipri.y(), Ipri.z(), volume*1e6);
     }
 }
@@ -1161,6 +1227,9 @@ void SolidEntity::BuildMultibodyLinkCollider(btMultiBody *mb, unsigned int child
         if(contactK > Scalar(0))
             multibodyCollider->setContactStiffnessAndDamping(contactK, contactD);
         
+        //Hydrodynamics
+        BuildHydrodynamicsMesh();
+        
         //Graphics
         BuildGraphicalObject();
         
@@ -1214,6 +1283,121 @@ void SolidEntity::UpdateAcceleration(Scalar dt)
     lastOmega = currentOmega;
 }
 
+void SolidEntity::SaveState(StateBuffer& state) const
+{
+    //Body (multibody links are moved by the multibody)
+    if(rigidBody != nullptr)
+    {
+        Transform graphicsTrans;
+        rigidBody->getMotionState()->getWorldTransform(graphicsTrans);
+        state.Write(rigidBody->getWorldTransform());
+        state.Write(rigidBody->getInterpolationWorldTransform());
+        state.Write(graphicsTrans);
+        state.Write(rigidBody->getLinearVelocity());
+        state.Write(rigidBody->getAngularVelocity());
+        state.Write(rigidBody->getInterpolationLinearVelocity());
+        state.Write(rigidBody->getInterpolationAngularVelocity());
+        state.Write(rigidBody->getActivationState());
+        state.Write(rigidBody->getDeactivationTime());
+    }
+    else if(multibodyCollider != nullptr)
+    {
+        state.Write(multibodyCollider->getActivationState());
+        state.Write(multibodyCollider->getDeactivationTime());
+    }
+    
+    //Motion
+    state.Write(filteredLinearVel);
+    state.Write(filteredAngularVel);
+    state.Write(linearAcc);
+    state.Write(angularAcc);
+    state.Write(lastV);
+    state.Write(lastOmega);
+    state.Write(linkLinearVelocity);
+    state.Write(linkAngularVelocity);
+    
+    //Fluid dynamics (forces are reused between computations)
+    state.Write(Fb);
+    state.Write(Tb);
+    state.Write(Fdq);
+    state.Write(Tdq);
+    state.Write(Fdf);
+    state.Write(Tdf);
+    state.Write(Fda);
+    state.Write(Tda);
+    state.Write(Swet);
+    state.Write(Vsub);
+    state.Write(hydroPosition);
+    state.Write(hydroSteps);
+    state.Write(hydroFlowV);
+    state.Write(hydroOmega);
+    state.Write(hydroComputed);
+}
+
+void SolidEntity::RestoreState(StateReader& state)
+{
+    int activation;
+    Scalar deactivationTime;
+    
+    if(rigidBody != nullptr)
+    {
+        Transform trans, interpTrans, graphicsTrans;
+        Vector3 v, omega, interpV, interpOmega;
+        state.Read(trans);
+        state.Read(interpTrans);
+        state.Read(graphicsTrans);
+        state.Read(v);
+        state.Read(omega);
+        state.Read(interpV);
+        state.Read(interpOmega);
+        state.Read(activation);
+        state.Read(deactivationTime);
+        
+        rigidBody->setWorldTransform(trans);
+        rigidBody->setInterpolationWorldTransform(interpTrans);
+        rigidBody->getMotionState()->setWorldTransform(graphicsTrans);
+        rigidBody->setLinearVelocity(v);
+        rigidBody->setAngularVelocity(omega);
+        rigidBody->setInterpolationLinearVelocity(interpV);
+        rigidBody->setInterpolationAngularVelocity(interpOmega);
+        rigidBody->clearForces();
+        rigidBody->forceActivationState(activation);
+        rigidBody->setDeactivationTime(deactivationTime);
+    }
+    else if(multibodyCollider != nullptr)
+    {
+        state.Read(activation);
+        state.Read(deactivationTime);
+        multibodyCollider->forceActivationState(activation);
+        multibodyCollider->setDeactivationTime(deactivationTime);
+    }
+    
+    state.Read(filteredLinearVel);
+    state.Read(filteredAngularVel);
+    state.Read(linearAcc);
+    state.Read(angularAcc);
+    state.Read(lastV);
+    state.Read(lastOmega);
+    state.Read(linkLinearVelocity);
+    state.Read(linkAngularVelocity);
+    
+    state.Read(Fb);
+    state.Read(Tb);
+    state.Read(Fdq);
+    state.Read(Tdq);
+    state.Read(Fdf);
+    state.Read(Tdf);
+    state.Read(Fda);
+    state.Read(Tda);
+    state.Read(Swet);
+    state.Read(Vsub);
+    state.Read(hydroPosition);
+    state.Read(hydroSteps);
+    state.Read(hydroFlowV);
+    state.Read(hydroOmega);
+    state.Read(hydroComputed);
+}
+
 void SolidEntity::ApplyGravity(const Vector3& g)
 {
     if(rigidBody != nullptr)
@@ -1260,15 +1444,19 @@ BodyFluidPosition SolidEntity::CheckBodyFluidPosition(Ocean* ocn)
     getAABB(aabbMin, aabbMax);
     Vector3 d = aabbMax-aabbMin;
     
+    GLfloat corners[3*8];
+    GLfloat depths[8];
+    for(unsigned int i=0; i<8; ++i)
+    {
+        corners[3*i] = (GLfloat)(aabbMin.x() + ((i & 1) ? d.x() : Scalar(0)));
+        corners[3*i+1] = (GLfloat)(aabbMin.y() + ((i & 2) ? d.y() : Scalar(0)));
+        corners[3*i+2] = (GLfloat)(aabbMin.z() + ((i & 4) ? d.z() : Scalar(0)));
+    }
+    ocn->GetDepth(corners, depths, 8);
+    
     unsigned int underwater = 0;
-    if(ocn->GetDepth(aabbMin) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMax) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), 0, 0)) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(0, d.y(), 0)) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), d.y(), 0)) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(0, 0, d.z())) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), 0, d.z())) > Scalar(0)) ++underwater;
-    if(ocn->GetDepth(aabbMin + Vector3(0, d.y(), d.z())) > Scalar(0)) ++underwater;
+    for(unsigned int i=0; i<8; ++i)
+        if(depths[i] > 0.f) ++underwater;
     
     if(underwater == 0)
         return BodyFluidPosition::OUTSIDE;
@@ -1305,11 +1493,11 @@ void SolidEntity::CorrectHydrodynamicForces(Ocean* ocn, Vector3& _Fdq, Vector3&
     _Tdf = ocn->getLiquid().density * Tdfc * _Tdf; //rho*S*v from viscous drag equation
 }
 
-void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const HydroMesh* hmesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
                                             const Vector3& _v, const Vector3& _omega, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
                                             Scalar& _Swet, Scalar& _Vsub, Renderable& debug)
 {
-    if(mesh == nullptr)
+    if(hmesh == nullptr || hmesh->nFaces == 0)
     {
         if(settings.reallisticBuoyancy)
         {
@@ -1350,22 +1538,39 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
     glm::vec3 p0 = p; //Point used as a center of mesh for volume calculation.
     p0.z = 0.f;       //When the robot is far from the world origin numerical erros would explode without translating the mesh data!
     
+    //Transform all vertices and sample the fluid depth once per vertex (vertices are shared between faces)
+    static thread_local std::vector<GLfloat> vertexPos; //World frame, x,y,z interleaved (reused between calls)
+    static thread_local std::vector<GLfloat> vertexDepth;
+    size_t nVertices = hmesh->vx.size();
+    vertexPos.resize(3 * nVertices);
+    vertexDepth.resize(nVertices);
+    glm::mat3 R = glm::mat3(TC);
+    glm::vec3 t = glm::vec3(TC[3]);
+    
+    for(size_t i=0; i<nVertices; ++i)
+    {
+        vertexPos[3*i] = R[0][0]*hmesh->vx[i] + R[1][0]*hmesh->vy[i] + R[2][0]*hmesh->vz[i] + t.x;
+        vertexPos[3*i+1] = R[0][1]*hmesh->vx[i] + R[1][1]*hmesh->vy[i] + R[2][1]*hmesh->vz[i] + t.y;
+        vertexPos[3*i+2] = R[0][2]*hmesh->vx[i] + R[1][2]*hmesh->vy[i] + R[2][2]*hmesh->vz[i] + t.z;
+    }
+    ocn->GetDepth(vertexPos.data(), vertexDepth.data(), nVertices);
+    
     //Loop through all faces...
-    for(size_t i=0; i<mesh->faces.size(); ++i)
+    for(size_t i=0; i<hmesh->nFaces; ++i)
     {
         //Global coordinates
-        glm::vec3 p1gl = mesh->getVertexPos(i, 0);
-        glm::vec3 p2gl = mesh->getVertexPos(i, 1);
-        glm::vec3 p3gl = mesh->getVertexPos(i, 2);
-        glm::vec3 p1 = glm::vec3(TC * glm::vec4(p1gl, 1.f));
-        glm::vec3 p2 = glm::vec3(TC * glm::vec4(p2gl, 1.f));
-        glm::vec3 p3 = glm::vec3(TC * glm::vec4(p3gl, 1.f));
+        GLuint id1 = hmesh->f0[i];
+        GLuint id2 = hmesh->f1[i];
+        GLuint id3 = hmesh->f2[i];
+        glm::vec3 p1(vertexPos[3*id1], vertexPos[3*id1+1], vertexPos[3*id1+2]);
+        glm::vec3 p2(vertexPos[3*id2], vertexPos[3*id2+1], vertexPos[3*id2+2]);
+        glm::vec3 p3(vertexPos[3*id3], vertexPos[3*id3+1], vertexPos[3*id3+2]);
         
         //Check if face underwater
         GLfloat depth[3];
-        depth[0] = ocn->GetDepth(p1);
-        depth[1] = ocn->GetDepth(p2);
-        depth[2] = ocn->GetDepth(p3);
+        depth[0] = vertexDepth[id1];
+        depth[1] = vertexDepth[id2];
+        depth[2] = vertexDepth[id3];
         
         if(depth[0] < 0.f && depth[1] < 0.f && depth[2] < 0.f)
             continue;
@@ -1813,6 +2018,121 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
     _Tdf = Vector3(Tdf.x, Tdf.y, Tdf.z);
 }
 
+void SolidEntity::ComputeHydrodynamicForcesSubmerged(const HydroMesh* hmesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf)
+{
+    if(hmesh == nullptr || hmesh->nFaces == 0)
+    {
+        _Fdq.setZero();
+        _Tdq.setZero();
+        _Fdf.setZero();
+        _Tdf.setZero();
+        return;
+    }
+
+    //Computation with floats (geometry has float precision)
+    glm::mat4 TCG = glMatrixFromTransform(T_CG);
+    glm::mat4 TC = glMatrixFromTransform(T_C);
+    glm::vec3 v = glVectorFromVector(_v);
+    glm::vec3 omega = glVectorFromVector(_omega);
+    glm::vec3 p = glm::vec3(TCG[3]);
+    glm::mat3 R = glm::mat3(TC);
+    glm::vec3 d = glm::vec3(TC[3]) - p; //Physics frame origin relative to CG
+    
+    //Faces are processed in blocks of constant width, with all data kept in plain arrays,
+    //so that the compiler can map the inner loops to SIMD lanes. Forces are accumulated per lane
+    //and summed at the end, to keep the inner loops free of horizontal reductions.
+    constexpr size_t W = HydroMesh::laneWidth;
+    GLfloat acc[12][W] = {}; //Fdq, Tdq, Fdf, Tdf
+    GLfloat rx[W], ry[W], rz[W]; //Face centroids relative to CG (world frame)
+    GLfloat fc[3*W]; //Face centroids (world frame)
+    GLfloat u[3*W]; //Fluid velocity at face centroids
+    
+    const GLfloat* cx = hmesh->cx.data();
+    const GLfloat* cy = hmesh->cy.data();
+    const GLfloat* cz = hmesh->cz.data();
+    const GLfloat* nx = hmesh->nx.data();
+    const GLfloat* ny = hmesh->ny.data();
+    const GLfloat* nz = hmesh->nz.data();
+    const GLfloat* area = hmesh->area.data();
+    
+    for(size_t b=0; b<hmesh->getNumOfPaddedFaces(); b+=W)
+    {
+        //Transform face centroids
+        for(size_t j=0; j<W; ++j)
+        {
+            size_t i = b+j;
+            rx[j] = R[0][0]*cx[i] + R[1][0]*cy[i] + R[2][0]*cz[i] + d.x;
+            ry[j] = R[0][1]*cx[i] + R[1][1]*cy[i] + R[2][1]*cz[i] + d.y;
+            rz[j] = R[0][2]*cx[i] + R[1][2]*cy[i] + R[2][2]*cz[i] + d.z;
+        }
+        
+        //Sample fluid velocity
+        for(size_t j=0; j<W; ++j)
+        {
+            fc[3*j] = rx[j] + p.x;
+            fc[3*j+1] = ry[j] + p.y;
+            fc[3*j+2] = rz[j] + p.z;
+        }
+        ocn->GetFluidVelocity(fc, u, W);
+        
+        //Forces
+        for(size_t j=0; j<W; ++j)
+        {
+            size_t i = b+j;
+            GLfloat fnx = R[0][0]*nx[i] + R[1][0]*ny[i] + R[2][0]*nz[i];
+            GLfloat fny = R[0][1]*nx[i] + R[1][1]*ny[i] + R[2][1]*nz[i];
+            GLfloat fnz = R[0][2]*nx[i] + R[1][2]*ny[i] + R[2][2]*nz[i];
+            GLfloat A = area[i];
+            
+            //Relative velocity of the fluid
+            GLfloat vcx = u[3*j] - (v.x + omega.y*rz[j] - omega.z*ry[j]);
+            GLfloat vcy = u[3*j+1] - (v.y + omega.z*rx[j] - omega.x*rz[j]);
+            GLfloat vcz = u[3*j+2] - (v.z + omega.x*ry[j] - omega.y*rx[j]);
+            GLfloat vc_n = vcx*fnx + vcy*fny + vcz*fnz;
+            
+            //Form drag (if liquid is approaching the surface)
+            GLfloat vmag = sqrtf(vcx*vcx + vcy*vcy + vcz*vcz);
+            GLfloat q = vc_n < -1e-12f ? vmag * -vc_n * A : 0.f;
+            GLfloat qx = vcx * q;
+            GLfloat qy = vcy * q;
+            GLfloat qz = vcz * q;
+            
+            //Skin friction (tangent velocity)
+            GLfloat vtx = vcx - vc_n * fnx;
+            GLfloat vty = vcy - vc_n * fny;
+            GLfloat vtz = vcz - vc_n * fnz;
+            GLfloat s = (vtx*vtx + vty*vty + vtz*vtz) > 1e-9f ? A : 0.f;
+            GLfloat sx = vtx * s;
+            GLfloat sy = vty * s;
+            GLfloat sz = vtz * s;
+            
+            acc[0][j] += qx;
+            acc[1][j] += qy;
+            acc[2][j] += qz;
+            acc[3][j] += ry[j]*qz - rz[j]*qy;
+            acc[4][j] += rz[j]*qx - rx[j]*qz;
+            acc[5][j] += rx[j]*qy - ry[j]*qx;
+            acc[6][j] += sx;
+            acc[7][j] += sy;
+            acc[8][j] += sz;
+            acc[9][j] += ry[j]*sz - rz[j]*sy;
+            acc[10][j] += rz[j]*sx - rx[j]*sz;
+            acc[11][j] += rx[j]*sy - ry[j]*sx;
+        }
+    }
+    
+    GLfloat sum[12] = {};
+    for(size_t k=0; k<12; ++k)
+        for(size_t j=0; j<W; ++j)
+            sum[k] += acc[k][j];
+    
+    _Fdq = Vector3(sum[0], sum[1], sum[2]);
+    _Tdq = Vector3(sum[3], sum[4], sum[5]);
+    _Fdf = Vector3(sum[6], sum[7], sum[8]);
+    _Tdf = Vector3(sum[9], sum[10], sum[11]);
+}
+
 void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean* ocn)
 {
     if(phy.mode != BodyPhysicsMode::FLOATING && phy.mode != BodyPhysicsMode::SUBMERGED) return;
@@ -1820,6 +2140,7 @@ void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocea
     submerged.points.clear();
 
     BodyFluidPosition bf = CheckBodyFluidPosition(ocn);
+    hydroPosition = bf;
     
     //If completely outside fluid just set all torques and forces to 0
     if(bf == BodyFluidPosition::OUTSIDE)
@@ -1850,20 +2171,55 @@ void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocea
         }
         
         if(settings.dampingForces)
-            ComputeHydrodynamicForcesSubmerged(getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf);
+            ComputeHydrodynamicForcesSubmerged(getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf);
 
         Swet = surface;
     }
     else //CROSSING_FLUID_SURFACE
     {
         if(!isBuoyant()) settings.reallisticBuoyancy = false;
-        ComputeHydrodynamicForcesSurface(settings, getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged);
+        ComputeHydrodynamicForcesSurface(settings, getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged);
     }
     
     if(settings.dampingForces)
         CorrectHydrodynamicForces(ocn, Fdq, Tdq, Fdf, Tdf);
 }
 
+bool SolidEntity::UpdateHydrodynamicsSchedule(Ocean* ocn, unsigned int basePeriod, const AdaptiveHydrodynamicsSettings& settings)
+{
+    if(phy.mode != BodyPhysicsMode::FLOATING && phy.mode != BodyPhysicsMode::SUBMERGED) return false;
+    
+    ++hydroSteps;
+    
+    //Sleeping bodies keep the last forces (they are in equilibrium)
+    if(hydroComputed 
+       && ((rigidBody != nullptr && !rigidBody->isActive())
+           || (multibodyCollider != nullptr && !multibodyCollider->m_multiBody->isAwake())))
+        return false;
+    
+    //Relative flow and its change since the last computation
+    Vector3 omega = getAngularVelocity();
+    Vector3 flowV = ocn->GetFluidVelocity(getCGTransform().getOrigin()) - getLinearVelocity();
+    Scalar L = btPow(volume, Scalar(1)/Scalar(3)); //Characteristic length
+    Scalar speed = flowV.length() + omega.length() * L;
+    Scalar change = (flowV - hydroFlowV).length() + (omega - hydroOmega).length() * L;
+    
+    unsigned int period = basePeriod;
+    if(hydroPosition == BodyFluidPosition::CROSSING_SURFACE) //Wetted surface changes with waves and motion
+        period = basePeriod > 1 ? basePeriod/2 : 1;
+    else if(speed < settings.quasiStaticSpeed && change < settings.quasiStaticChange) //Quasi-static
+        period = basePeriod * settings.quasiStaticFactor;
+    
+    if(hydroComputed && hydroSteps < period && change < settings.minChange + settings.relativeChange * speed)
+        return false;
+    
+    hydroSteps = 0;
+    hydroFlowV = flowV;
+    hydroOmega = omega;
+    hydroComputed = true;
+    return true;
+}
+
 void SolidEntity::ComputeAerodynamicForces(Atmosphere* atm)
 {
     if(phy.mode != BodyPhysicsMode::AERODYNAMIC) return;
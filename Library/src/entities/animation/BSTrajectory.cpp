@@ -25,6 +25,7 @@
 
 #include "entities/animation/BSTrajectory.h"
 #include <algorithm>
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -78,6 +79,18 @@ void BSTrajectory::AddKeyPoint(Scalar keyTime, Transform keyTransform)
     Interpolate();
 }
 
+void BSTrajectory::SaveState(StateBuffer& state) const
+{
+    Trajectory::SaveState(state);
+    state.Write(lastPlayTime);
+}
+
+void BSTrajectory::RestoreState(StateReader& state)
+{
+    Trajectory::RestoreState(state);
+    state.Read(lastPlayTime);
+}
+
 void BSTrajectory::Interpolate()
 {
     if(points.size() < 3)
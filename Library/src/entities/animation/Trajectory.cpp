@@ -25,6 +25,8 @@
 
 #include "entities/animation/Trajectory.h"
 
+#include "utils/StateBuffer.h"
+
 namespace sf
 {
 
@@ -47,6 +49,28 @@ unsigned int Trajectory::getPlaybackIteration() const
     return iteration;
 }
 
+void Trajectory::SaveState(StateBuffer& state) const
+{
+    state.Write(playTime);
+    state.Write(iteration);
+    state.Write(forward);
+    state.Write(interpTrans);
+    state.Write(interpVel);
+    state.Write(interpAngVel);
+    state.Write(interpAcc);
+}
+
+void Trajectory::RestoreState(StateReader& state)
+{
+    state.Read(playTime);
+    state.Read(iteration);
+    state.Read(forward);
+    state.Read(interpTrans);
+    state.Read(interpVel);
+    state.Read(interpAngVel);
+    state.Read(interpAcc);
+}
+
 Transform Trajectory::getInterpolatedTransform() const
 {
     return interpTrans;
@@ -28,6 +28,7 @@
 #include "entities/forcefields/VelocityField.h"
 #include "entities/SolidEntity.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/TickProfiler.h"
 
 namespace sf
 {
@@ -144,36 +145,22 @@ bool Atmosphere::IsInsideFluid(const Vector3& point) const
 
 void Atmosphere::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute)
 {
-    Entity* ent;
-    btRigidBody* rb = btRigidBody::upcast(co);
-    btMultiBodyLinkCollider* mbl = btMultiBodyLinkCollider::upcast(co);
-    
-    if(rb != 0)
-    {
-        if(rb->isStaticOrKinematicObject())
-            return;
-        else
-            ent = (Entity*)rb->getUserPointer();
-    }
-    else if(mbl != 0)
-    {
-        if(mbl->isStaticOrKinematicObject())
-            return;
-        else
-            ent = (Entity*)mbl->getUserPointer();
-    }
-    else
-        return;
-    
-    if(ent->getType() == EntityType::SOLID)
-    {
-        if(recompute)
-        {
-            ((SolidEntity*)ent)->ComputeAerodynamicForces(this);
-        }
-        
-        ((SolidEntity*)ent)->ApplyAerodynamicForces();
-    }
+    Entity* ent = getDynamicEntity(co);
+    if(ent != nullptr && ent->getType() == EntityType::SOLID)
+        ApplyFluidForces((SolidEntity*)ent, recompute);
+}
+
+void Atmosphere::ComputeFluidForces(SolidEntity* solid)
+{
+    ProfileScope scope(TickProfiler::isEnabled() ? TickProfiler::Intern(solid->getName()) : nullptr, "Aerodynamics");
+    solid->ComputeAerodynamicForces(this);
+}
+
+void Atmosphere::ApplyFluidForces(SolidEntity* solid, bool recompute)
+{
+    if(recompute)
+        ComputeFluidForces(solid);
+    solid->ApplyAerodynamicForces();
 }
 
 int Atmosphere::JulianDay(std::tm& tm)
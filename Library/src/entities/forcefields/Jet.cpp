@@ -69,6 +69,37 @@ Vector3 Jet::GetVelocityAtPoint(const Vector3& p) const
     return f*vmax;
 }
 
+void Jet::AddVelocityAtPoints(const GLfloat* xyz, GLfloat* out, size_t count) const
+{
+    GLfloat cx = (GLfloat)c.getX();
+    GLfloat cy = (GLfloat)c.getY();
+    GLfloat cz = (GLfloat)c.getZ();
+    GLfloat nx = (GLfloat)n.getX();
+    GLfloat ny = (GLfloat)n.getY();
+    GLfloat nz = (GLfloat)n.getZ();
+    GLfloat r5 = (GLfloat)(Scalar(5)*r);
+    GLfloat r10vout = (GLfloat)(Scalar(10)*r*vout);
+    
+    //Branch-free version of GetVelocityAtPoint
+    for(size_t i=0; i<count; ++i)
+    {
+        GLfloat cpx = xyz[3*i] - cx;
+        GLfloat cpy = xyz[3*i+1] - cy;
+        GLfloat cpz = xyz[3*i+2] - cz;
+        GLfloat ax = cpy*nz - cpz*ny;
+        GLfloat ay = cpz*nx - cpx*nz;
+        GLfloat az = cpx*ny - cpy*nx;
+        GLfloat d2 = ax*ax + ay*ay + az*az; //Squared distance to axis
+        GLfloat t = cpx*nx + cpy*ny + cpz*nz; //Distance from outlet
+        GLfloat r_ = (t + r5)/5.f; //Radius at point
+        GLfloat f = expf(-50.f*d2/(t*t)) * r10vout/(t + r5);
+        f = (t > 0.f && d2 < r_*r_) ? f : 0.f;
+        out[3*i] += f*nx;
+        out[3*i+1] += f*ny;
+        out[3*i+2] += f*nz;
+    }
+}
+
 std::vector<Renderable> Jet::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -27,7 +27,9 @@
 
 #include <algorithm>
 #include "utils/SystemUtil.hpp"
+#include "utils/TickProfiler.h"
 #include "entities/forcefields/VelocityField.h"
+#include "entities/forcefields/SpectralWaves.h"
 #include "entities/SolidEntity.h"
 #include "graphics/OpenGLFlatOcean.h"
 #include "graphics/OpenGLRealOcean.h"
@@ -57,6 +59,11 @@ Ocean::Ocean(std::string uniqueName, Scalar waves, Fluid l) : ForcefieldEntity(u
     wavesDebug.model = glm::mat4(1.f);
     waterType = Scalar(0.0);
     glOcean = nullptr;
+    cpuWaves = nullptr;
+    
+    //Without graphics the waves are simulated on the CPU
+    if(hasWaves() && !SimulationApp::getApp()->hasGraphics())
+        cpuWaves = new SpectralWaves(oceanState);
 }
 
 Ocean::~Ocean()
@@ -70,6 +77,9 @@ Ocean::~Ocean()
     
     if(glOcean != nullptr)
         delete glOcean;
+    
+    if(cpuWaves != nullptr)
+        delete cpuWaves;
 }
 
 bool Ocean::hasWaves() const
@@ -142,7 +152,7 @@ float Ocean::GetDepth(const glm::vec3& point)
 {
     if(hasWaves()) //Geometric waves
     {
-        GLfloat waveHeight = glOcean->ComputeWaveHeight(point.x, point.y);
+        GLfloat waveHeight = cpuWaves != nullptr ? cpuWaves->ComputeWaveHeight(point.x, point.y) : glOcean->ComputeWaveHeight(point.x, point.y);
         glm::vec3 wavePoint(point.x, point.y, waveHeight);
 #ifdef DEBUG_WAVES
         wavesDebug.points.push_back(wavePoint);
@@ -159,6 +169,30 @@ float Ocean::GetDepth(const glm::vec3& point)
     }
 }
 
+void Ocean::GetDepth(const GLfloat* xyz, GLfloat* depths, size_t count)
+{
+    if(hasWaves()) //Geometric waves
+    {
+        if(cpuWaves != nullptr)
+            cpuWaves->ComputeWaveHeight(xyz, depths, count);
+        else
+            glOcean->ComputeWaveHeight(xyz, depths, count);
+        
+        for(size_t i=0; i<count; ++i)
+        {
+#ifdef DEBUG_WAVES
+            wavesDebug.points.push_back(glm::vec3(xyz[3*i], xyz[3*i+1], depths[i]));
+#endif
+            depths[i] = xyz[3*i+2] - depths[i];
+        }
+    }
+    else //Flat surface
+    {
+        for(size_t i=0; i<count; ++i)
+            depths[i] = xyz[3*i+2];
+    }
+}
+
 Scalar Ocean::GetDepth(const Vector3& point)
 {
     return Scalar(GetDepth(glm::vec3((GLfloat)point.getX(), (GLfloat)point.getY(), (GLfloat)point.getZ())));
@@ -192,6 +226,25 @@ glm::vec3 Ocean::GetFluidVelocity(const glm::vec3& point) const
     return glVectorFromVector(GetFluidVelocity(Vector3(point.x, point.y, point.z)));
 }
 
+void Ocean::GetFluidVelocity(const GLfloat* xyz, GLfloat* out, size_t count) const
+{
+    std::fill(out, out + 3*count, 0.f);
+    if(currentsEnabled)
+    {
+        for(size_t i=0; i<currents.size(); ++i)
+        {
+            if(currents[i]->isEnabled())
+                currents[i]->AddVelocityAtPoints(xyz, out, count);
+        }
+    }
+}
+
+void Ocean::UpdateWaves(Scalar t)
+{
+    if(cpuWaves != nullptr)
+        cpuWaves->Update(t);
+}
+
 void Ocean::EnableCurrents()
 {
     currentsEnabled = true;
@@ -202,48 +255,38 @@ void Ocean::DisableCurrents()
     currentsEnabled = false;
 }
 
-void Ocean::UpdateCurrentsData()
+void Ocean::UpdateCurrentsData(const OceanCurrentsUBO& data)
 {
     if(glOcean != NULL)
-        glOcean->UpdateOceanCurrentsData(glOceanCurrentsUBOData);
+        glOcean->UpdateOceanCurrentsData(data);
+}
+
+const OceanCurrentsUBO& Ocean::getCurrentsData() const
+{
+    return glOceanCurrentsUBOData;
 }
 
 void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute)
 {
-    Entity* ent;
-    btRigidBody* rb = btRigidBody::upcast(co);
-    btMultiBodyLinkCollider* mbl = btMultiBodyLinkCollider::upcast(co);
-    
-    if(rb != 0)
-    {
-        if(rb->isStaticOrKinematicObject())
-            return;
-        else
-            ent = (Entity*)rb->getUserPointer();
-    }
-    else if(mbl != 0)
-    {
-        if(mbl->isStaticOrKinematicObject())
-            return;
-        else
-            ent = (Entity*)mbl->getUserPointer();
-    }
-    else
-        return;
-    
+    Entity* ent = getDynamicEntity(co);
+    if(ent != nullptr && ent->getType() == EntityType::SOLID)
+        ApplyFluidForces((SolidEntity*)ent, recompute);
+}
+
+void Ocean::ComputeFluidForces(SolidEntity* solid)
+{
+    ProfileScope scope(TickProfiler::isEnabled() ? TickProfiler::Intern(solid->getName()) : nullptr, "Hydrodynamics");
     HydrodynamicsSettings settings;
-    
-    if(ent->getType() == EntityType::SOLID)
-    {
-        if(recompute)
-        {
-            settings.dampingForces = true;
-            settings.reallisticBuoyancy = true;
-            ((SolidEntity*)ent)->ComputeHydrodynamicForces(settings, this);
-        }
-        
-        ((SolidEntity*)ent)->ApplyHydrodynamicForces();
-    }
+    settings.dampingForces = true;
+    settings.reallisticBuoyancy = true;
+    solid->ComputeHydrodynamicForces(settings, this);
+}
+
+void Ocean::ApplyFluidForces(SolidEntity* solid, bool recompute)
+{
+    if(recompute)
+        ComputeFluidForces(solid);
+    solid->ApplyHydrodynamicForces();
 }
 
 void Ocean::InitGraphics(SDL_mutex* hydrodynamics)
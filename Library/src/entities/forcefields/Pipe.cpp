@@ -67,6 +67,40 @@ Vector3 Pipe::GetVelocityAtPoint(const Vector3& p) const
     return f*v;
 }
 
+void Pipe::AddVelocityAtPoints(const GLfloat* xyz, GLfloat* out, size_t count) const
+{
+    GLfloat px = (GLfloat)p1.getX();
+    GLfloat py = (GLfloat)p1.getY();
+    GLfloat pz = (GLfloat)p1.getZ();
+    GLfloat nx = (GLfloat)n.getX();
+    GLfloat ny = (GLfloat)n.getY();
+    GLfloat nz = (GLfloat)n.getZ();
+    GLfloat l_ = (GLfloat)l;
+    GLfloat r1_ = (GLfloat)r1;
+    GLfloat dr = (GLfloat)((r2-r1)/l);
+    GLfloat r1vin = (GLfloat)(r1*vin);
+    GLfloat gamma_ = (GLfloat)gamma;
+    
+    //Branch-free version of GetVelocityAtPoint
+    for(size_t i=0; i<count; ++i)
+    {
+        GLfloat ppx = xyz[3*i] - px;
+        GLfloat ppy = xyz[3*i+1] - py;
+        GLfloat ppz = xyz[3*i+2] - pz;
+        GLfloat ax = ppy*nz - ppz*ny;
+        GLfloat ay = ppz*nx - ppx*nz;
+        GLfloat az = ppx*ny - ppy*nx;
+        GLfloat d = sqrtf(ax*ax + ay*ay + az*az); //Distance to axis
+        GLfloat t = ppx*nx + ppy*ny + ppz*nz; //Position along axis
+        GLfloat r = r1_ + dr*t; //Radius at point
+        bool inside = t >= 0.f && t <= l_ && d < r;
+        GLfloat f = inside ? powf(1.f - d/r, gamma_) * r1vin/r : 0.f;
+        out[3*i] += f*nx;
+        out[3*i+1] += f*ny;
+        out[3*i+2] += f*nz;
+    }
+}
+
 std::vector<Renderable> Pipe::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -0,0 +1,345 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SpectralWaves.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+/*
+    Based on "Real-time Animation and Rendering of Ocean Whitecaps"
+    by Jonathan Dupuy and Eric Bruneton.
+    https://github.com/jdupuy/whitecaps
+*/
+
+#include "entities/forcefields/SpectralWaves.h"
+
+#include <algorithm>
+#include "utils/SystemUtil.hpp"
+#include "utils/TaskScheduler.h"
+
+namespace sf
+{
+
+SpectralWaves::SpectralWaves(Scalar state)
+{
+    //Same parameters as the OpenGL ocean
+    passes = 8;
+    fftSize = 1 << passes;
+    gridSizes[0] = 893.f;
+    gridSizes[1] = 101.f;
+    propagate = true;
+    km = 370.f;
+    cm = 0.23f;
+    wind = (float)state*5.f + 2.f;
+    A = 1.f;
+    omegaSea = 5.f*expf(-(float)state) + 0.2f;
+    updatePeriod = Scalar(1)/Scalar(60);
+
+    //FFT tables
+    twiddle.resize(fftSize/2);
+    for(int k=0; k<fftSize/2; ++k)
+        twiddle[k] = std::polar(1.f, 2.f*(float)M_PI*(float)k/(float)fftSize);
+
+    reversed.resize(fftSize);
+    for(int i=0; i<fftSize; ++i)
+    {
+        int r = 0;
+        for(int b=0; b<passes; ++b)
+            if(i & (1 << b)) r |= 1 << (passes - 1 - b);
+        reversed[i] = r;
+    }
+
+    waves.resize(fftSize * fftSize);
+    GenerateWavesSpectrum();
+    Simulate(Scalar(0));
+}
+
+void SpectralWaves::setUpdatePeriod(Scalar period)
+{
+    updatePeriod = period < Scalar(0) ? Scalar(0) : period;
+}
+
+Scalar SpectralWaves::getTime() const
+{
+    return time;
+}
+
+void SpectralWaves::Update(Scalar t)
+{
+    if(t < time || t - time >= updatePeriod)
+        Simulate(t);
+}
+
+void SpectralWaves::Simulate(Scalar t)
+{
+    const float sqrt2 = 1.414213562f;
+    const int N = fftSize;
+
+    //Spectrum at time t (h1 + i*h2 packing, as in the OpenGL ocean)
+    TaskScheduler::ParallelFor(0, N, [this, t, N, sqrt2](size_t row)
+    {
+        int y = (int)row;
+        for(int x=0; x<N; ++x)
+        {
+            int xs = x >= N/2 ? x - N : x;
+            int ys = y >= N/2 ? y - N : y;
+            int id = y * N + x;
+            int idc = ((N - y) % N) * N + (N - x) % N; //Conjugate -k
+            std::complex<float> h[2];
+
+            for(int g=0; g<2; ++g)
+            {
+                float kx = 2.f * (float)M_PI * (float)xs/gridSizes[g];
+                float ky = 2.f * (float)M_PI * (float)ys/gridSizes[g];
+                float k = sqrtf(kx * kx + ky * ky);
+                float w = omega(k);
+                float c = (float)cos(w * t);
+                float s = (float)sin(w * t);
+                std::complex<float> s0 = h0[g][id] * sqrt2;
+                std::complex<float> s0c = h0[g][idc] * sqrt2;
+                h[g] = std::complex<float>((s0.real() + s0c.real()) * c - (s0.imag() + s0c.imag()) * s,
+                                           (s0.real() - s0c.real()) * s + (s0.imag() - s0c.imag()) * c);
+            }
+
+            waves[id] = std::complex<float>(h[0].real() - h[1].imag(), h[0].imag() + h[1].real());
+        }
+    }, 4);
+
+    //Inverse FFT along rows
+    TaskScheduler::ParallelFor(0, N, [this, N](size_t y) { FFT(&waves[y * N]); }, 4);
+
+    //Inverse FFT along columns
+    TaskScheduler::ParallelFor(0, N, [this, N](size_t x)
+    {
+        std::vector<std::complex<float>> column(N);
+        for(int y=0; y<N; ++y)
+            column[y] = waves[y * N + x];
+        FFT(column.data());
+        for(int y=0; y<N; ++y)
+            waves[y * N + x] = column[y];
+    }, 4);
+
+    time = t;
+}
+
+float SpectralWaves::ComputeWaveHeight(float x, float y) const
+{
+    //Z,X are reversed because the coordinate system used to draw ocean has Z axis pointing up!
+    float z = 0.f;
+    z -= ComputeInterpolatedWaveData(x/gridSizes[0], y/gridSizes[0], false);
+    z -= ComputeInterpolatedWaveData(x/gridSizes[1], y/gridSizes[1], true);
+    return z;
+}
+
+void SpectralWaves::ComputeWaveHeight(const float* xyz, float* heights, size_t count) const
+{
+    //Same as the single point version but without branches, so that it can be vectorised.
+    //Texel coordinates are wrapped with a mask (FFT size is a power of 2).
+    const int N = fftSize;
+    const int mask = N - 1;
+    const float s[2] = {(float)N/gridSizes[0], (float)N/gridSizes[1]};
+    const float* data = reinterpret_cast<const float*>(waves.data()); //Real and imaginary parts interleaved
+
+    for(size_t i=0; i<count; ++i)
+    {
+        float z = 0.f;
+        for(int c=0; c<2; ++c)
+        {
+            float u = xyz[3*i] * s[c] - 0.5f;
+            float v = xyz[3*i+1] * s[c] - 0.5f;
+            float fu = floorf(u);
+            float fv = floorf(v);
+            float alpha = u - fu;
+            float beta = v - fv;
+            int i0 = (int)fu & mask;
+            int j0 = (int)fv & mask;
+            int i1 = (i0 + 1) & mask;
+            int j1 = (j0 + 1) & mask;
+            z -= (1.f - alpha)*(1.f - beta)*data[(j0 * N + i0) * 2 + c] + alpha*(1.f - beta)*data[(j0 * N + i1) * 2 + c]
+                 + (1.f - alpha)*beta*data[(j1 * N + i0) * 2 + c] + alpha*beta*data[(j1 * N + i1) * 2 + c];
+        }
+        heights[i] = z;
+    }
+}
+
+float SpectralWaves::ComputeInterpolatedWaveData(float x, float y, bool imaginary) const
+{
+    //Bilinear interpolation with wrapping, the same as in the OpenGL ocean
+    float tmp;
+
+    //First coordinate pair
+    float i0f = modff(x - 0.5f/(float)fftSize, &tmp);
+    float j0f = modff(y - 0.5f/(float)fftSize, &tmp);
+    if(i0f < 0.f) i0f = 1.f - fabsf(i0f);
+    if(j0f < 0.f) j0f = 1.f - fabsf(j0f);
+    int i0 = std::min((int)truncf(i0f * (float)fftSize), fftSize-1);
+    int j0 = std::min((int)truncf(j0f * (float)fftSize), fftSize-1);
+
+    //Second coordinate pair
+    float i1f = modff(x + 0.5f/(float)fftSize, &tmp);
+    float j1f = modff(y + 0.5f/(float)fftSize, &tmp);
+    if(i1f < 0.f) i1f = 1.f - fabsf(i1f);
+    if(j1f < 0.f) j1f = 1.f - fabsf(j1f);
+    int i1 = std::min((int)truncf(i1f * (float)fftSize), fftSize-1);
+    int j1 = std::min((int)truncf(j1f * (float)fftSize), fftSize-1);
+
+    //Calculate weigths
+    float alpha = modff(i0f * (float)fftSize, &tmp);
+    float beta = modff(j0f * (float)fftSize, &tmp);
+
+    //Get texel values
+    float t[4];
+    if(imaginary)
+    {
+        t[0] = waves[j0 * fftSize + i0].imag();
+        t[1] = waves[j0 * fftSize + i1].imag();
+        t[2] = waves[j1 * fftSize + i0].imag();
+        t[3] = waves[j1 * fftSize + i1].imag();
+    }
+    else
+    {
+        t[0] = waves[j0 * fftSize + i0].real();
+        t[1] = waves[j0 * fftSize + i1].real();
+        t[2] = waves[j1 * fftSize + i0].real();
+        t[3] = waves[j1 * fftSize + i1].real();
+    }
+
+    //Interpolate
+    return (1.f - alpha)*(1.f - beta)*t[0] + alpha*(1.f - beta)*t[1] + (1.f - alpha)*beta*t[2] + alpha*beta*t[3];
+}
+
+void SpectralWaves::FFT(std::complex<float>* data)
+{
+    //Iterative radix-2 transform with positive exponent and without normalisation (inverse FFT)
+    for(int i=0; i<fftSize; ++i)
+        if(i < reversed[i])
+            std::swap(data[i], data[reversed[i]]);
+
+    for(int size=2; size<=fftSize; size *= 2)
+    {
+        int half = size/2;
+        int step = fftSize/size;
+        for(int start=0; start<fftSize; start += size)
+            for(int k=0; k<half; ++k)
+            {
+                std::complex<float> u = data[start + k];
+                std::complex<float> v = data[start + k + half] * twiddle[k * step];
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+    }
+}
+
+//Wave generation (see OpenGLOcean)
+float SpectralWaves::omega(float k)
+{
+    return sqrtf(9.81f * k * (1.f + (k/km) * (k/km))); // Eq 24
+}
+
+float SpectralWaves::spectrum(float kx, float ky)
+{
+    float U10 = wind;
+    float Omega = omegaSea;
+
+    // phase speed
+    float k = sqrtf(kx * kx + ky * ky);
+    float c = omega(k) / k;
+
+    // spectral peak
+    float kp = 9.81f * (Omega / U10) * (Omega / U10); // after Eq 3
+    float cp = omega(kp) / kp;
+
+    // friction velocity
+    float z0 = 3.7e-5f * U10 * U10 / 9.81f * powf(U10 / cp, 0.9f); // Eq 66
+    float u_star = 0.41f * U10 / logf(10.f / z0); // Eq 60
+
+    float Lpm = expf(- 5.f / 4.f * (kp / k) * (kp / k)); // after Eq 3
+    float gamma = Omega < 1.f ? 1.7f : 1.7f + 6.f * logf(Omega); // after Eq 3
+    float sigma = 0.08f * (1.f + 4.f / powf(Omega, 3.f)); // after Eq 3
+    float Gamma = expf(-1.f / (2.f * sigma * sigma) * (sqrtf(k / kp) - 1.f) * (sqrtf(k / kp) - 1.f));
+    float Jp = powf(gamma, Gamma); // Eq 3
+    float Fp = Lpm * Jp * expf(- Omega / sqrtf(10.f) * (sqrtf(k / kp) - 1.f)); // Eq 32
+    float alphap = 0.006f * sqrtf(Omega); // Eq 34
+    float Bl = 0.5f * alphap * cp / c * Fp; // Eq 31
+
+    float alpham = 0.01f * (u_star < cm ? 1.f + logf(u_star / cm) : 1.f + 3.f * logf(u_star / cm)); // Eq 44
+    float Fm = expf(-0.25f * (k / km - 1.f) * (k / km - 1.f)); // Eq 41
+    float Bh = 0.5f * alpham * cm / c * Fm; // Eq 40
+    Bh *= Lpm;
+
+    float a0 = logf(2.f) / 4.f;
+    float ap = 4.f;
+    float am = 0.13f * u_star / cm; // Eq 59
+    float Delta = tanhf(a0 + ap * powf(c / cp, 2.5f) + am * powf(cm / c, 2.5f)); // Eq 57
+    float phi = atan2f(ky, kx);
+
+    if(propagate)
+    {
+        if(kx < 0.f)
+            return 0.f;
+        Bl *= 2.f;
+        Bh *= 2.f;
+    }
+
+    return A * (Bl + Bh) * (1.f + Delta * cosf(2.f * phi)) / (2.f * (float)M_PI * k * k * k * k); // Eq 67
+}
+
+void SpectralWaves::GetSpectrumSample(int i, int j, float lengthScale, float kMin, long* seed, std::complex<float>& result)
+{
+    float dk = 2.f * (float)M_PI / lengthScale;
+    float kx = i * dk;
+    float ky = j * dk;
+    if(fabsf(kx) < kMin && fabsf(ky) < kMin)
+        result = std::complex<float>(0.f, 0.f);
+    else
+    {
+        float S = spectrum(kx, ky);
+        float h = sqrtf(S / 2.f) * dk;
+        float phi = frandom(seed) * 2.f * (float)M_PI;
+        result = std::polar(h, phi);
+    }
+}
+
+void SpectralWaves::GenerateWavesSpectrum()
+{
+    //The random sequence has to follow the OpenGL ocean, which samples four grids
+    const float allGridSizes[4] = {893.f, 101.f, 21.f, 11.f};
+    long seed = 1234;
+    std::complex<float> unused;
+    h0[0].resize(fftSize * fftSize);
+    h0[1].resize(fftSize * fftSize);
+
+    for(int y = 0; y < fftSize; ++y)
+    {
+        for(int x = 0; x < fftSize; ++x)
+        {
+            int id = x + y * fftSize;
+            int i = x >= fftSize / 2 ? x - fftSize : x;
+            int j = y >= fftSize / 2 ? y - fftSize : y;
+            GetSpectrumSample(i, j, allGridSizes[0], M_PI / allGridSizes[0], &seed, h0[0][id]);
+            GetSpectrumSample(i, j, allGridSizes[1], M_PI * fftSize / allGridSizes[0], &seed, h0[1][id]);
+            GetSpectrumSample(i, j, allGridSizes[2], M_PI * fftSize / allGridSizes[1], &seed, unused);
+            GetSpectrumSample(i, j, allGridSizes[3], M_PI * fftSize / allGridSizes[2], &seed, unused);
+        }
+    }
+}
+
+}
@@ -48,6 +48,20 @@ Vector3 Uniform::GetVelocityAtPoint(const Vector3& p) const
     return v;
 }
 
+void Uniform::AddVelocityAtPoints(const GLfloat* xyz, GLfloat* out, size_t count) const
+{
+    GLfloat vx = (GLfloat)v.getX();
+    GLfloat vy = (GLfloat)v.getY();
+    GLfloat vz = (GLfloat)v.getZ();
+    
+    for(size_t i=0; i<count; ++i)
+    {
+        out[3*i] += vx;
+        out[3*i+1] += vy;
+        out[3*i+2] += vz;
+    }
+}
+
 std::vector<Renderable> Uniform::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -46,4 +46,15 @@ bool VelocityField::isEnabled() const
     return enabled;
 }
 
+void VelocityField::AddVelocityAtPoints(const GLfloat* xyz, GLfloat* out, size_t count) const
+{
+    for(size_t i=0; i<count; ++i)
+    {
+        Vector3 v = GetVelocityAtPoint(Vector3(xyz[3*i], xyz[3*i+1], xyz[3*i+2]));
+        out[3*i] += (GLfloat)v.getX();
+        out[3*i+1] += (GLfloat)v.getY();
+        out[3*i+2] += (GLfloat)v.getZ();
+    }
+}
+
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "utils/GeometryFileUtil.h"
+#include "utils/TaskScheduler.h"
 
 namespace sf
 {
@@ -295,6 +296,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
     submerged.points.clear();
 
     BodyFluidPosition bf = CheckBodyFluidPosition(ocn);
+    hydroPosition = bf;
      
     //If completely outside fluid just set all torques and forces to 0
     if(bf == BodyFluidPosition::OUTSIDE)
@@ -310,120 +312,167 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
         return;
     }
     
+    //Data shared by all parts (gravity taken here, as parts may be computed by other threads)
+    Vector3 g = SimulationApp::getApp()->getSimulationManager()->getGravity();
+    Vector3 v = getLinearVelocity();
+    Vector3 omega = getAngularVelocity();
+    
     if(bf == BodyFluidPosition::INSIDE)
     {
         //Compute buoyancy based on CB position
         if(isBuoyant())
         {
-            Fb = -volume*ocn->getLiquid().density * SimulationApp::getApp()->getSimulationManager()->getGravity();
+            Fb = -volume*ocn->getLiquid().density * g;
             Tb = (getCGTransform() * P_CB - getCGTransform().getOrigin()).cross(Fb);
         }
         
-        if(settings.dampingForces)
-        {
-            //Set zero
-            Fdq.setZero();
-            Tdq.setZero();
-            Fdf.setZero();
-            Tdf.setZero();
-            
-            //Get velocity data
-            Vector3 v = getLinearVelocity();
-            Vector3 omega = getAngularVelocity();
-            
-            //Create temporary vectors for summing
-            Vector3 Fdqp(0,0,0);
-            Vector3 Tdqp(0,0,0);
-            Vector3 Fdfp(0,0,0);
-            Vector3 Tdfp(0,0,0);
-            
-            for(size_t i=0; i<parts.size(); ++i) //Go through all parts
-                if(parts[i].isExternal 
-                    && (parts[i].solid->getBodyPhysicsMode() == BodyPhysicsMode::SUBMERGED
-                    || parts[i].solid->getBodyPhysicsMode() == BodyPhysicsMode::FLOATING)) //Compute drag only for external parts
-                {
-                    Transform T_C_part = getOTransform() * parts[i].origin * parts[i].solid->getO2CTransform();
-                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp);
-                    parts[i].solid->CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp);
-                    Fdq += Fdqp;
-                    Tdq += Tdqp;
-                    Fdf += Fdfp;
-                    Tdf += Tdfp;
-                }
-        }
-
         Swet = surface;
         Vsub = volume;
+        
+        if(!settings.dampingForces)
+            return;
     }
-    else //CROSSING FLUID SURFACE (compound body but not necessarily all parts!)
+    else if(!settings.reallisticBuoyancy && !settings.dampingForces)
+        return;
+    
+    //Compute parts as separate tasks, that can be taken by idle threads
+    partHydro.resize(parts.size());
+    TaskScheduler::ParallelFor(0, parts.size(), [&](size_t i)
     {
-        if(settings.reallisticBuoyancy || settings.dampingForces)
+        ComputePartHydrodynamics(i, bf, settings, ocn, g, v, omega);
+    });
+    
+    //Sum the results in a fixed order
+    if(bf == BodyFluidPosition::CROSSING_SURFACE)
+    {
+        if(settings.reallisticBuoyancy)
         {
-            //Clear forces that will be recomputed
-            if(settings.reallisticBuoyancy)
-            {
-                Fb.setZero();
-                Tb.setZero();
-            }
+            Fb.setZero();
+            Tb.setZero();
+        }
+        Swet = Scalar(0);
+        Vsub = Scalar(0);
+    }
+    Fdq.setZero();
+    Tdq.setZero();
+    Fdf.setZero();
+    Tdf.setZero();
+    
+    for(size_t i=0; i<partHydro.size(); ++i)
+    {
+        const CompoundPartHydrodynamics& ph = partHydro[i];
+        Fdq += ph.Fdq;
+        Tdq += ph.Tdq;
+        Fdf += ph.Fdf;
+        Tdf += ph.Tdf;
         
-            if(settings.dampingForces)
-            {
-                Fdq.setZero();
-                Tdq.setZero();
-                Fdf.setZero();
-                Tdf.setZero();
-            }
+        if(bf == BodyFluidPosition::CROSSING_SURFACE)
+        {
+            Fb += ph.Fb;
+            Tb += ph.Tb;
+            Swet += ph.Swet;
+            Vsub += ph.Vsub;
+            submerged.points.insert(submerged.points.end(), ph.submerged.points.begin(), ph.submerged.points.end());
+        }
+    }
+}
 
-            Swet = Scalar(0);
-            Vsub = Scalar(0);
-        
-            //Get velocity data
-            Vector3 v = getLinearVelocity();
-            Vector3 omega = getAngularVelocity();
+BodyFluidPosition Compound::CheckPartFluidPosition(size_t partId, const Transform& T_C_part, Ocean* ocn)
+{
+    //Corners of the part bounding box (tighter than the world-aligned box)
+    const HydroMesh* hmesh = parts[partId].solid->getHydroMesh();
+    if(hmesh == nullptr)
+        return BodyFluidPosition::OUTSIDE;
+    
+    GLfloat corners[3*8];
+    GLfloat depths[8];
+    for(unsigned int i=0; i<8; ++i)
+    {
+        Vector3 c((i & 1) ? hmesh->aabbMax.x : hmesh->aabbMin.x,
+                  (i & 2) ? hmesh->aabbMax.y : hmesh->aabbMin.y,
+                  (i & 4) ? hmesh->aabbMax.z : hmesh->aabbMin.z);
+        c = T_C_part * c;
+        corners[3*i] = (GLfloat)c.x();
+        corners[3*i+1] = (GLfloat)c.y();
+        corners[3*i+2] = (GLfloat)c.z();
+    }
+    ocn->GetDepth(corners, depths, 8);
+    
+    unsigned int underwater = 0;
+    for(unsigned int i=0; i<8; ++i)
+        if(depths[i] > 0.f) ++underwater;
+    
+    if(underwater == 0)
+        return BodyFluidPosition::OUTSIDE;
+    else if(underwater == 8)
+        return BodyFluidPosition::INSIDE;
+    else
+        return BodyFluidPosition::CROSSING_SURFACE;
+}
+
+void Compound::ComputePartHydrodynamics(size_t partId, BodyFluidPosition bf, const HydrodynamicsSettings& settings, Ocean* ocn,
+                                        const Vector3& g, const Vector3& v, const Vector3& omega)
+{
+    CompoundPartHydrodynamics& ph = partHydro[partId];
+    ph.Fb.setZero();
+    ph.Tb.setZero();
+    ph.Fdq.setZero();
+    ph.Tdq.setZero();
+    ph.Fdf.setZero();
+    ph.Tdf.setZero();
+    ph.Swet = Scalar(0);
+    ph.Vsub = Scalar(0);
+    ph.submerged.points.clear();
+    
+    SolidEntity* part = parts[partId].solid;
+    if(part->getBodyPhysicsMode() != BodyPhysicsMode::SUBMERGED
+        && part->getBodyPhysicsMode() != BodyPhysicsMode::FLOATING)
+        return;
+    
+    HydrodynamicsSettings pSettings = settings;
+    pSettings.reallisticBuoyancy &= part->isBuoyant();
+    pSettings.dampingForces &= parts[partId].isExternal; //Compute drag only for external parts
+    if(bf == BodyFluidPosition::INSIDE)
+        pSettings.reallisticBuoyancy = false; //Buoyancy computed for the whole body
+    if(!pSettings.reallisticBuoyancy && !pSettings.dampingForces)
+        return;
+    
+    Transform T_C_part = getOTransform() * parts[partId].origin * part->getO2CTransform();
+    
+    //Classify the part before running any face loop
+    if(bf == BodyFluidPosition::CROSSING_SURFACE)
+        bf = CheckPartFluidPosition(partId, T_C_part, ocn);
+    
+    if(bf == BodyFluidPosition::OUTSIDE)
+        return;
+    else if(bf == BodyFluidPosition::INSIDE)
+    {
+        //Buoyancy based on the CB of the part (no clipping of faces needed)
+        if(pSettings.reallisticBuoyancy)
+        {
+            Vector3 P_CB_part = getOTransform() * parts[partId].origin * part->getCG2OTransform().inverse() * part->getCB();
+            ph.Fb = -part->getVolume() * ocn->getLiquid().density * g;
+            ph.Tb = (P_CB_part - getCGTransform().getOrigin()).cross(ph.Fb);
+        }
         
-            //Create temporary vectors for summing
-            Vector3 Fbp(0,0,0);
-            Vector3 Tbp(0,0,0);
-            Vector3 Fdqp(0,0,0);
-            Vector3 Tdqp(0,0,0);
-            Vector3 Fdfp(0,0,0);
-            Vector3 Tdfp(0,0,0);
-            Scalar Swetp(0);
-            Scalar Vsubp(0);
-
-            for(size_t i=0; i<parts.size(); ++i) //Loop through all parts
-            {
-                if(parts[i].solid->getBodyPhysicsMode() != BodyPhysicsMode::SUBMERGED
-                    && parts[i].solid->getBodyPhysicsMode() != BodyPhysicsMode::FLOATING)
-                    continue;
-
-                Transform T_C_part = getOTransform() * parts[i].origin * parts[i].solid->getO2CTransform();
-                HydrodynamicsSettings pSettings = settings;
-                pSettings.reallisticBuoyancy &= parts[i].solid->isBuoyant();
-
-                if(parts[i].isExternal) //Compute buoyancy and drag
-                {
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
-                    parts[i].solid->CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp);
-                    Fb += Fbp;
-                    Tb += Tbp;
-                    Fdq += Fdqp;
-                    Tdq += Tdqp;
-                    Fdf += Fdfp;
-                    Tdf += Tdfp;
-                    Swet += Swetp;
-                    Vsub += Vsubp;
-                }
-                else if(pSettings.reallisticBuoyancy) //Compute only buoyancy
-                {
-                    pSettings.dampingForces = false;
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
-                    Fb += Fbp;
-                    Tb += Tbp;
-                    Vsub += Vsubp;
-                }
-            }
+        if(pSettings.dampingForces)
+        {
+            ComputeHydrodynamicForcesSubmerged(part->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, ph.Fdq, ph.Tdq, ph.Fdf, ph.Tdf);
+            part->CorrectHydrodynamicForces(ocn, ph.Fdq, ph.Tdq, ph.Fdf, ph.Tdf);
         }
+        
+        ph.Vsub = part->getVolume();
+        if(parts[partId].isExternal)
+            ph.Swet = part->getSurface();
+    }
+    else //CROSSING_SURFACE
+    {
+        ComputeHydrodynamicForcesSurface(pSettings, part->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, 
+                                         ph.Fb, ph.Tb, ph.Fdq, ph.Tdq, ph.Fdf, ph.Tdf, ph.Swet, ph.Vsub, ph.submerged);
+        if(pSettings.dampingForces)
+            part->CorrectHydrodynamicForces(ocn, ph.Fdq, ph.Tdq, ph.Fdf, ph.Tdf);
+        if(!parts[partId].isExternal)
+            ph.Swet = Scalar(0); //Internal parts are not wetted
     }
 }
 
@@ -460,6 +509,12 @@ void Compound::BuildGraphicalObject()
         parts[i].solid->BuildGraphicalObject();
 }
 
+void Compound::BuildHydrodynamicsMesh()
+{
+    for(size_t i=0; i<parts.size(); ++i)
+        parts[i].solid->BuildHydrodynamicsMesh();
+}
+
 std::vector<Renderable> Compound::Render(size_t partId)
 {
     std::vector<Renderable> items(0);
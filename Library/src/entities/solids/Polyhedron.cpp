@@ -39,34 +39,40 @@ Polyhedron::Polyhedron(std::string uniqueName, BodyPhysicsSettings phy,
                        std::string material, std::string look, Scalar thickness, GeometryApproxType approx)
                         : SolidEntity(uniqueName, phy, material, look, thickness)
 {
-    //1.Load geometry from file
-    graMesh = OpenGLContent::LoadMesh(graphicsFilename, graphicsScale, false);
-    T_O2G = graphicsOrigin;
-    
+    //1.Load geometry from file (processed geometry is shared between bodies using the same file)
+    const ProcessedGeometry* geom;
     if(physicsFilename != "")
     {
-        phyMesh = OpenGLContent::LoadMesh(physicsFilename, physicsScale, false);
+        geom = LoadProcessedGeometry(physicsFilename, physicsScale, 3.f, thickness, mat.density);
+        colCacheKey = MakeGeometryCacheKey(physicsFilename, std::to_string(physicsScale) + "@3");
+        graMesh = OpenGLContent::LoadMesh(graphicsFilename, graphicsScale, false);
         T_O2C = physicsOrigin;
     }
     else
     {
-        phyMesh = graMesh;
-        T_O2C = T_O2G;
+        geom = LoadProcessedGeometry(graphicsFilename, graphicsScale, 3.f, thickness, mat.density);
+        colCacheKey = MakeGeometryCacheKey(graphicsFilename, std::to_string(graphicsScale) + "@3");
+        graMesh = geom->mesh;
+        T_O2C = graphicsOrigin;
     }
-    
-    OpenGLContent::Refine(phyMesh, 3.f);
+    phyMesh = geom->mesh;
+    T_O2G = graphicsOrigin;
     
     //2. Compute physical properties
-    Vector3 CG;
-    Matrix3 Irot;
-    ComputePhysicalProperties(phyMesh, thickness, mat.density, mass, CG, volume, surface, Ipri, Irot);
-    T_CG2C.setOrigin(-CG); //Set CG position
-    T_CG2C = Transform(Irot, Vector3(0,0,0)).inverse() * T_CG2C; //Align CG frame to principal axes of inertia
+    mass = geom->properties.mass;
+    volume = geom->properties.volume;
+    surface = geom->properties.surface;
+    Ipri = geom->properties.Ipri;
+    T_CG2C.setOrigin(-geom->properties.CG); //Set CG position
+    T_CG2C = Transform(geom->properties.Irot, Vector3(0,0,0)).inverse() * T_CG2C; //Align CG frame to principal axes of inertia
     T_CG2O = T_CG2C * T_O2C.inverse();
     T_CG2G = T_CG2O * T_O2G;
 
     //3.Calculate equivalent ellipsoid for hydrodynamic force computation
-    ComputeFluidDynamicsApprox(approx);
+    if(approx == GeometryApproxType::AUTO || approx == GeometryApproxType::ELLIPSOID)
+        SetEllipsoidalApprox(geom->ellipsoidAxes);
+    else
+        ComputeFluidDynamicsApprox(approx);
     T_O2H = T_CG2O.inverse() * T_CG2H;
     P_CB = Vector3(0,0,0);
 }
@@ -89,18 +95,14 @@ SolidType Polyhedron::getSolidType()
     return SolidType::POLYHEDRON;
 }
 
+void Polyhedron::setCollisionGeometry(const CollisionGeometrySettings& settings)
+{
+    colSettings = settings;
+}
+
 btCollisionShape* Polyhedron::BuildCollisionShape()
 {
-    btConvexHullShape* convex = new btConvexHullShape();
-    for(size_t i=0; i<phyMesh->getNumOfVertices(); ++i)
-    {
-        glm::vec3 pos = phyMesh->getVertexPos(i);
-        Vector3 v(pos.x, pos.y, pos.z);
-        convex->addPoint(v);
-    }
-    //convex->optimizeConvexHull();
-    convex->setMargin(0);
-    return convex;
+    return CreateConvexCollisionShape(BuildCollisionHulls(phyMesh, colSettings, colCacheKey));
 }
 
 void Polyhedron::BuildGraphicalObject()
@@ -27,6 +27,7 @@
 
 #include "graphics/OpenGLContent.h"
 #include "utils/GeometryFileUtil.h"
+#include "utils/CollisionGeometry.h"
 
 namespace sf
 {
@@ -123,16 +124,7 @@ SolidType Wing::getSolidType()
     
 btCollisionShape* Wing::BuildCollisionShape()
 {
-    btConvexHullShape* convex = new btConvexHullShape();
-    for(size_t i=0; i<phyMesh->getNumOfVertices(); ++i)
-    {
-        glm::vec3 pos = phyMesh->getVertexPos(i);
-        Vector3 v(pos.x, pos.y, pos.z);
-        convex->addPoint(v);
-    }
-    //convex->optimizeConvexHull();
-    convex->setMargin(0);
-    return convex;
+    return CreateConvexCollisionShape(BuildCollisionHulls(phyMesh, CollisionGeometrySettings()));
 }
 
 }
@@ -100,6 +100,43 @@ void Terrain::getAABB(Vector3 &min, Vector3 &max)
         max.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
 }
 
+void Terrain::RayTest(const RayBatch& rays, RayHits& hits) const
+{
+    size_t n = rays.size();
+    hits.fraction.resize(n);
+    hits.normal.resize(n);
+    hits.entity.resize(n);
+    
+    Transform rayFrom = Transform::getIdentity();
+    Transform rayTo = Transform::getIdentity();
+    
+    for(size_t i=0; i<n; ++i)
+    {
+        btCollisionWorld::ClosestRayResultCallback closest(rays.from[i], rays.to[i]);
+        
+        if(rigidBody != NULL)
+        {
+            //Heightfield traversed cell by cell along the ray
+            rayFrom.setOrigin(rays.from[i]);
+            rayTo.setOrigin(rays.to[i]);
+            btCollisionWorld::rayTestSingle(rayFrom, rayTo, rigidBody, rigidBody->getCollisionShape(), rigidBody->getWorldTransform(), closest);
+        }
+        
+        if(closest.hasHit())
+        {
+            hits.fraction[i] = closest.m_closestHitFraction;
+            hits.normal[i] = closest.m_hitNormalWorld;
+            hits.entity[i] = (Entity*)rigidBody->getUserPointer();
+        }
+        else
+        {
+            hits.fraction[i] = Scalar(1);
+            hits.normal[i] = V0();
+            hits.entity[i] = nullptr;
+        }
+    }
+}
+
 void Terrain::AddToSimulation(SimulationManager* sm, const Transform& origin)
 {
     if(rigidBody != NULL)
@@ -26,6 +26,9 @@
 #include "graphics/GLSLShader.h"
 
 #include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include "core/SimulationApp.h"
 #include "graphics/OpenGLState.h"
 #include "utils/SystemUtil.hpp"
@@ -39,66 +42,149 @@ namespace sf
 
 GLuint GLSLShader::saqVertexShader = 0;
 bool GLSLShader::verbose = true;
+std::string GLSLShader::programCacheDir = "";
+bool GLSLShader::programBinarySupported = false;
+std::map<GLuint, uint64_t> GLSLShader::shaderHashes;
+GLSLProgramStats GLSLShader::stats = {0, 0, 0.0, 0.0};
 
-GLSLShader::GLSLShader(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
+#define PROGRAM_CACHE_VERSION 1
+
+struct ProgramCacheHeader
 {
-    valid = false;
-    program = 0;
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t length;
+};
 
-    if(sources.size() > 0)
+//FNV-1a
+static uint64_t HashBytes(uint64_t h, const void* data, size_t length)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for(size_t i=0; i<length; ++i)
     {
-        valid = true;
-        
-        std::vector<GLuint> shaders = precompiled;
-        GLint compiled = 0;
+        h ^= bytes[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
 
-        for(size_t i=0; i<sources.size(); ++i)
-        {
-            GLuint shader = LoadShader(sources[i].type, sources[i].filename, sources[i].header, &compiled);
-            if(compiled == 0)
-            {
-                valid = false;
-                break;
-            }
-            shaders.push_back(shader);
-        }
+static uint64_t HashString(uint64_t h, const char* str)
+{
+    return str == NULL ? h : HashBytes(h, str, strlen(str) + 1);
+}
 
-        if(valid)
-        {
-            program = CreateProgram(shaders, precompiled.size());
-            if(program == 0)
-                valid = false;
-        }
-    }
+GLSLShader::GLSLShader(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
+{
+    Build(sources, precompiled);
 }
 
 GLSLShader::GLSLShader(const std::vector<GLuint>& precompiled)
 {
+    int64_t start = GetTimeInMicroseconds();
     program = CreateProgram(precompiled, precompiled.size());
     if(program == 0)
         valid = false;
     else 
         valid = true;
+    ++stats.compiledPrograms;
+    stats.compileTime += (GetTimeInMicroseconds() - start)/1e6;
 }
 
 GLSLShader::GLSLShader(std::string fragment, std::string vertex)
 {
-    valid = false;
-    GLint compiled = 0;
-    GLuint vs;
-    GLuint fs;
-    std::string emptyHeader = "";
-    
     if(vertex == "")
-        vs = saqVertexShader;
+        Build({GLSLSource(GL_FRAGMENT_SHADER, fragment)}, {saqVertexShader});
     else
-        vs = LoadShader(GL_VERTEX_SHADER, vertex, emptyHeader, &compiled);
+        Build({GLSLSource(GL_VERTEX_SHADER, vertex), GLSLSource(GL_FRAGMENT_SHADER, fragment)}, {});
+}
     
-    fs = LoadShader(GL_FRAGMENT_SHADER, fragment, emptyHeader, &compiled);
-    program = CreateProgram({vs, fs}, vs == saqVertexShader ? 1 : 0);
+void GLSLShader::Build(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
+{
+    valid = false;
+    program = 0;
+
+    if(sources.size() == 0)
+        return;
+
+    int64_t start = GetTimeInMicroseconds();
+
+    //Resolve sources (headers and injected files)
+    std::vector<std::string> texts(sources.size());
+    for(size_t i=0; i<sources.size(); ++i)
+        if(!LoadShaderSource(sources[i].filename, sources[i].header, texts[i]))
+            return;
+
+    //Try to load the linked program from cache
+    std::string cacheFilename = "";
+    if(programCacheDir != "" && programBinarySupported)
+    {
+        uint64_t h = 14695981039346656037ULL;
+        h = HashString(h, (const char*)glGetString(GL_VENDOR));
+        h = HashString(h, (const char*)glGetString(GL_RENDERER));
+        h = HashString(h, (const char*)glGetString(GL_VERSION));
+        bool cacheable = true;
+        for(size_t i=0; i<precompiled.size(); ++i)
+        {
+            auto it = shaderHashes.find(precompiled[i]);
+            if(it == shaderHashes.end()) //Unknown origin of the shader
+            {
+                cacheable = false;
+                break;
+            }
+            h = HashBytes(h, &it->second, sizeof(uint64_t));
+        }
+        for(size_t i=0; i<sources.size(); ++i)
+        {
+            h = HashBytes(h, &sources[i].type, sizeof(GLenum));
+            h = HashString(h, texts[i].c_str());
+        }
+
+        if(cacheable)
+        {
+            char name[32];
+            snprintf(name, 32, "%016llx.sfprog", (unsigned long long)h);
+            cacheFilename = (std::filesystem::path(programCacheDir) / name).string();
+            program = LoadProgramBinary(cacheFilename);
+            if(program != 0)
+            {
+                valid = true;
+                ++stats.cachedPrograms;
+                stats.cacheTime += (GetTimeInMicroseconds() - start)/1e6;
+                return;
+            }
+        }
+    }
+
+    //Compile and link from source
     valid = true;
+    std::vector<GLuint> shaders = precompiled;
+    GLint compiled = 0;
+
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        GLuint shader = CompileShader(sources[i].type, texts[i], &compiled);
+        if(compiled == 0)
+        {
+            valid = false;
+            break;
+        }
+        shaders.push_back(shader);
+    }
+
+    if(valid)
+    {
+        program = CreateProgram(shaders, precompiled.size());
+        if(program == 0)
+            valid = false;
+        else if(cacheFilename != "")
+            SaveProgramBinary(program, cacheFilename);
+    }
+
+    ++stats.compiledPrograms;
+    stats.compileTime += (GetTimeInMicroseconds() - start)/1e6;
 }
-    
+
 GLSLShader::~GLSLShader()
 {
     if(valid)
@@ -417,6 +503,10 @@ bool GLSLShader::BindShaderStorageBlock(std::string name, GLuint bindingPoint)
 //// Statics
 bool GLSLShader::Init()
 {
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    programBinarySupported = formats > 0;
+    
     GLint compiled;
     std::string emptyHeader = "";
     saqVertexShader = LoadShader(GL_VERTEX_SHADER, "saq.vert", emptyHeader, &compiled);
@@ -426,7 +516,11 @@ bool GLSLShader::Init()
 void GLSLShader::Destroy()
 {
     if(saqVertexShader != 0)
-        glDeleteProgram(saqVertexShader);
+    {
+        glDeleteShader(saqVertexShader);
+        shaderHashes.erase(saqVertexShader);
+        saqVertexShader = 0;
+    }
 }
 
 void GLSLShader::Silent()
@@ -439,16 +533,48 @@ void GLSLShader::Verbose()
     verbose = true;
 }
 
+void GLSLShader::EnableProgramCache(const std::string& directory)
+{
+    programCacheDir = directory;
+    if(programCacheDir != "")
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(programCacheDir, ec);
+        if(ec)
+        {
+            cWarning("Failed to create shader program cache directory: %s", programCacheDir.c_str());
+            programCacheDir = "";
+        }
+    }
+}
+
+GLSLProgramStats GLSLShader::getProgramStats()
+{
+    return stats;
+}
+
 GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint *shaderCompiled)
 {
+    int64_t start = GetTimeInMicroseconds();
+    std::string source;
     GLuint shader = 0;
+    if(LoadShaderSource(filename, header, source))
+        shader = CompileShader(shaderType, source, shaderCompiled);
+    else
+        *shaderCompiled = 0;
+    stats.compileTime += (GetTimeInMicroseconds() - start)/1e6;
+    return shader;
+}
+
+bool GLSLShader::LoadShaderSource(const std::string& filename, const std::string& header, std::string& source)
+{
     std::string sourcePath = GetShaderPath() + filename;
 #ifdef EMBEDDED_RESOURCES
     ResourceHandle rh(sourcePath);
     if(!rh.isValid())
     {
         cCritical("Shader resource not found: %s", sourcePath.c_str());
-        return 0;
+        return false;
     }
     std::istringstream sourceString(rh.string());
     std::istream& sourceBuf(sourceString);
@@ -457,7 +583,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     if(!sourceFile.is_open())
     {
         cCritical("Shader file not found: %s", sourcePath.c_str());
-        return 0;
+        return false;
     }
     std::istream& sourceBuf(sourceFile);
 #endif
@@ -465,7 +591,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     if(verbose)
         cInfo("Loading shader from: %s", sourcePath.c_str());
 #endif
-    std::string source = header + "\n";
+    source = header + "\n";
     std::string line;
     while(!sourceBuf.eof())
     {
@@ -486,7 +612,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
                 if(!rh2.isValid())
                 {
                     cCritical("Shader include resource not found: %s", injectedPath.c_str());
-                    return 0;
+                    return false;
                 }
                 std::istringstream injectedString(rh2.string());
                 std::istream& injectedBuf(injectedString);
@@ -497,7 +623,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
                 {
                     sourceFile.close();
                     cCritical("Shader include file not found: %s", injectedPath.c_str());
-                    return 0;
+                    return false;
                 }
                 std::istream& injectedBuf(injectedFile);
 #endif
@@ -519,6 +645,12 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
 #ifndef EMBEDDED_RESOURCES
     sourceFile.close();
 #endif    
+    return true;
+}
+
+GLuint GLSLShader::CompileShader(GLenum shaderType, const std::string& source, GLint* shaderCompiled)
+{
+    GLuint shader = 0;
     const char* shaderSource = source.c_str();
     if(shaderSource != NULL)
     {
@@ -531,6 +663,8 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
             cError("Failed to compile shader: %s", shaderSource);
             shader = 0;
         }
+        else //Identify the shader when it is reused in program cache keys
+            shaderHashes[shader] = HashString(HashBytes(14695981039346656037ULL, &shaderType, sizeof(GLenum)), shaderSource);
 #ifdef DEBUG	
         GLint infoLogLength = 0;	
         glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
@@ -557,6 +691,8 @@ GLuint GLSLShader::CreateProgram(const std::vector<GLuint>& compiledShaders, uns
         if(compiledShaders[i] > 0)
             glAttachShader(program, compiledShaders[i]);
     
+    if(programCacheDir != "" && programBinarySupported)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program);
 #ifdef DEBUG
     GLint infoLogLength = 0;
@@ -575,8 +711,11 @@ GLuint GLSLShader::CreateProgram(const std::vector<GLuint>& compiledShaders, uns
         if(compiledShaders[i] > 0)
         {
             glDetachShader(program, compiledShaders[i]);
-            if(i > doNotDeleteNFirstShaders-1)
+            if(i >= doNotDeleteNFirstShaders)
+            {
                 glDeleteShader(compiledShaders[i]);
+                shaderHashes.erase(compiledShaders[i]);
+            }
         }
     }
     
@@ -590,4 +729,83 @@ GLuint GLSLShader::CreateProgram(const std::vector<GLuint>& compiledShaders, uns
     return program;
 }
 
+GLuint GLSLShader::LoadProgramBinary(const std::string& filename)
+{
+    std::error_code ec;
+    uint64_t fileSize = (uint64_t)std::filesystem::file_size(filename, ec);
+    if(ec)
+        return 0;
+    
+    FILE* file = fopen(filename.c_str(), "rb");
+    if(file == NULL)
+        return 0;
+    
+    ProgramCacheHeader h;
+    std::vector<char> data;
+    bool ok = fileSize >= sizeof(ProgramCacheHeader)
+              && fread(&h, sizeof(ProgramCacheHeader), 1, file) == 1
+              && memcmp(h.magic, "SFPB", 4) == 0
+              && h.version == PROGRAM_CACHE_VERSION
+              && h.length > 0
+              && h.length == fileSize - sizeof(ProgramCacheHeader); //A corrupted file is a cache miss and not a huge allocation
+    if(ok)
+    {
+        data.resize(h.length);
+        ok = fread(data.data(), 1, h.length, file) == h.length;
+    }
+    fclose(file);
+    if(!ok)
+        return 0;
+    
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)h.format, data.data(), (GLsizei)h.length);
+    GLint programLinked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &programLinked);
+    if(programLinked == 0) //Binary rejected by the driver -> fall back to compilation
+    {
+        while(glGetError() != GL_NO_ERROR) {}
+        glDeleteProgram(program);
+#ifdef DEBUG
+        cWarning("Program binary rejected: %s", filename.c_str());
+#endif
+        return 0;
+    }
+    return program;
+}
+
+void GLSLShader::SaveProgramBinary(GLuint program, const std::string& filename)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0)
+        return;
+    
+    std::vector<char> data(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, data.data());
+    if(length <= 0)
+        return;
+    
+    ProgramCacheHeader h;
+    memcpy(h.magic, "SFPB", 4);
+    h.version = PROGRAM_CACHE_VERSION;
+    h.format = (uint32_t)format;
+    h.length = (uint32_t)length;
+    
+    //Write to a uniquely named temporary file and rename, so that a partial file is never read
+    std::string tmpFilename = filename + "." + std::to_string(GetTimeInNanoseconds()) + ".tmp";
+    FILE* file = fopen(tmpFilename.c_str(), "wb");
+    if(file == NULL)
+        return;
+    bool ok = fwrite(&h, sizeof(ProgramCacheHeader), 1, file) == 1
+              && fwrite(data.data(), 1, h.length, file) == h.length;
+    ok = (fclose(file) == 0) && ok;
+    
+    std::error_code ec;
+    if(ok)
+        std::filesystem::rename(tmpFilename, filename, ec);
+    if(!ok || ec)
+        std::filesystem::remove(tmpFilename, ec);
+}
+
 }
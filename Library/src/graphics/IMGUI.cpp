@@ -836,13 +836,16 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
     DrawRoundedRect(x, y, w, h, theme[PLOT_COLOR]);
     
     //data
-    const std::vector<Sample>* data = sens->getHistory();
-    
-    if(data->size() > 1)
+    sens->LockHistory();
+    HistoryView data = sens->getHistoryView();
+    size_t dataCount = data.size();
+    GLfloat minValue = 0.f;
+    GLfloat maxValue = 0.f;
+    GLfloat dy = 0.f;
+    std::vector<std::vector<glm::vec2>> points(dims.size());
+    
+    if(dataCount > 1)
     {
-        GLfloat minValue;
-        GLfloat maxValue;
-        
         if(fixedRange != NULL)
         {
             minValue = fixedRange[0];
@@ -853,11 +856,11 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
             minValue = 10e12;
             maxValue = -10e12;
         
-            for(size_t i = 0; i < data->size(); ++i)
+            for(size_t i = 0; i < dataCount; ++i)
             {
                 for(size_t n = 0; n < dims.size(); ++n)
                 {
-                    GLfloat value = (GLfloat)((*data)[i].getValue(dims[n]));
+                    GLfloat value = (GLfloat)data.getValue(i, dims[n]);
                     if(value > maxValue)
                         maxValue = value;
                     if(value < minValue)
@@ -872,11 +875,26 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
             }
         }
         
-        GLfloat dy = (pltH-2.f*pltMargin)/(maxValue-minValue);
+        dy = (pltH-2.f*pltMargin)/(maxValue-minValue);
         
         //autostretch
-        GLfloat dt = pltW/(GLfloat)(data->size()-1);
+        GLfloat dt = pltW/(GLfloat)(dataCount-1);
+        
+        for(size_t n = 0; n < dims.size(); ++n)
+        {
+            points[n].reserve(dataCount);
+            for(size_t i = 0;  i < dataCount; ++i)
+            {
+                GLfloat value = (GLfloat)data.getValue(i, dims[n]);
+                points[n].push_back(glm::vec2(pltX + dt*i, pltY - pltH + pltMargin + (value-minValue) * dy));
+            }
+        }
+    }
+    
+    sens->UnlockHistory();
     
+    if(dataCount > 1)
+    {
         //drawing
         for(size_t n = 0; n < dims.size(); ++n)
         {
@@ -889,13 +907,6 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
                 color = theme[FILLED_COLOR];
             
             //draw graph
-            std::vector<glm::vec2> points;
-            for(size_t i = 0;  i < data->size(); ++i)
-            {
-                GLfloat value = (GLfloat)((*data)[i].getValue(dims[n]));
-                points.push_back(glm::vec2(pltX + dt*i, pltY - pltH + pltMargin + (value-minValue) * dy));
-            }
-            
             GLuint vbo;
             glGenBuffers(1, &vbo);
         
@@ -903,11 +914,11 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
             guiShader[0]->SetUniform("color", color);
         
             glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*points.size(), &points[0].x, GL_STATIC_DRAW);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*points[n].size(), &points[n][0].x, GL_STATIC_DRAW);
             glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(GLfloat), (void*)0);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
         
-            glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)points.size());
+            glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)points[n].size());
             
             OpenGLState::UseProgram(0);
             glDeleteBuffers(1, &vbo);
@@ -953,8 +964,6 @@ bool IMGUI::DoTimePlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, Scala
             DrawPlainText(x + backgroundMargin, y + backgroundMargin, theme[PLOT_TEXT_COLOR], buffer);
         }
     }
-    
-    delete data;
         
     //title
     glm::vec2 titleDim = PlainTextDimensions(title);
@@ -1145,15 +1154,27 @@ bool IMGUI::DoXYPlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, ScalarS
     DrawRoundedRect(x, y, w, h, theme[PLOT_COLOR]);
     
     //data
-    const std::vector<Sample>* dataX = sensX->getHistory();
-    const std::vector<Sample>* dataY = sensY->getHistory();
+    std::vector<glm::vec2> values;
     
-    if((dataX->size() > 1) && (dataY->size() > 1))
+    sensX->LockHistory();
+    if(sensY != sensX)
+        sensY->LockHistory();
+    
+    HistoryView dataX = sensX->getHistoryView();
+    HistoryView dataY = sensY->getHistoryView();
+    
+    //common sample count
+    size_t dataCount = dataX.size() < dataY.size() ? dataX.size() : dataY.size();
+    values.reserve(dataCount);
+    for(size_t i = 0; i < dataCount; ++i)
+        values.push_back(glm::vec2((GLfloat)dataX.getValue(i, dimX), (GLfloat)dataY.getValue(i, dimY)));
+    
+    if(sensY != sensX)
+        sensY->UnlockHistory();
+    sensX->UnlockHistory();
+    
+    if(dataCount > 1)
     {
-        //common sample count
-        unsigned long dataCount = dataX->size();
-        if(dataY->size() < dataCount)
-            dataCount = dataY->size();
         
         //autoscale X axis
         GLfloat minValueX = 10e12;
@@ -1161,7 +1182,7 @@ bool IMGUI::DoXYPlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, ScalarS
         
         for(size_t i = 0; i < dataCount; ++i)
         {
-            GLfloat value = (GLfloat)((*dataX)[i].getValue(dimX));
+            GLfloat value = values[i].x;
             if(value > maxValueX)
                 maxValueX = value;
             if(value < minValueX)
@@ -1182,7 +1203,7 @@ bool IMGUI::DoXYPlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, ScalarS
         
         for(size_t i = 0; i < dataCount; ++i)
         {
-            GLfloat value = (GLfloat)((*dataY)[i].getValue(dimY));
+            GLfloat value = values[i].y;
             if(value > maxValueY)
                 maxValueY = value;
             if(value < minValueY)
@@ -1202,9 +1223,7 @@ bool IMGUI::DoXYPlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, ScalarS
         
         for(size_t i = 0;  i < dataCount; ++i)
         {
-            GLfloat valueX = (GLfloat)((*dataX)[i].getValue(dimX));
-            GLfloat valueY = (GLfloat)((*dataY)[i].getValue(dimY));
-            points.push_back(glm::vec2(pltX + (valueX - minValueX) * dx, pltY - pltH + (valueY - minValueY) * dy));
+            points.push_back(glm::vec2(pltX + (values[i].x - minValueX) * dx, pltY - pltH + (values[i].y - minValueY) * dy));
         }
         
         GLuint vbo;
@@ -1258,9 +1277,6 @@ bool IMGUI::DoXYPlot(Uid id, GLfloat x, GLfloat y, GLfloat w, GLfloat h, ScalarS
         }
     }
     
-    delete dataX;
-    delete dataY;
-    
     //title
     glm::vec2 titleDim = PlainTextDimensions(title);
     DrawPlainText(x + floorf((w - titleDim.x) / 2.f), y + backgroundMargin, theme[PLOT_TEXT_COLOR], title);
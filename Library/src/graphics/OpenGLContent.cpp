@@ -26,6 +26,10 @@
 #include "graphics/OpenGLContent.h"
 
 #include <map>
+#include <set>
+#include <array>
+#include <queue>
+#include <limits>
 #include <algorithm>
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
@@ -2563,14 +2567,13 @@ void OpenGLContent::Refine(Mesh* mesh, GLfloat sizeThreshold)
     while(1)
     {
         std::vector<Face> newFaces;
+        std::map<std::pair<GLuint, GLuint>, GLuint> lookup; //Edge midpoints shared between neighbouring faces
         
         for(size_t i=0; i<mesh->faces.size(); ++i)
         {
             if(mesh->ComputeFaceArea(i) > sizeThreshold * avgFaceArea)
             {
                 GLuint mid[3];
-                std::map<std::pair<GLuint, GLuint>, GLuint> lookup;
-                
                 for(unsigned int edge = 0; edge<3; ++edge)
                     mid[edge] = vertex4Edge(lookup, mesh, mesh->faces[i].vertexID[edge], mesh->faces[i].vertexID[(edge+1)%3]);
                 
@@ -2616,6 +2619,314 @@ void OpenGLContent::Refine(Mesh* mesh, GLfloat sizeThreshold)
     cInfo("Mesh refined (%ld/%ld).", nFaceBefore, mesh->faces.size());
 #endif
 }
+
+template<typename V> static void CompactVertices(std::vector<V>& vertices, std::vector<Face>& faces)
+{
+    std::vector<GLuint> remap(vertices.size(), GLuint(-1));
+    std::vector<V> compact;
+    compact.reserve(vertices.size());
+    for(size_t i=0; i<faces.size(); ++i)
+        for(unsigned short k=0; k<3; ++k)
+        {
+            GLuint& id = faces[i].vertexID[k];
+            if(remap[id] == GLuint(-1))
+            {
+                remap[id] = (GLuint)compact.size();
+                compact.push_back(vertices[id]);
+            }
+            id = remap[id];
+        }
+    vertices.swap(compact);
+}
+
+static void CompactVertices(Mesh* mesh)
+{
+    if(mesh->isTexturable())
+        CompactVertices(static_cast<TexturableMesh*>(mesh)->vertices, mesh->faces);
+    else
+        CompactVertices(static_cast<PlainMesh*>(mesh)->vertices, mesh->faces);
+}
+
+static void SetVertexPos(Mesh* mesh, size_t vertexID, const glm::vec3& pos)
+{
+    if(mesh->isTexturable())
+        static_cast<TexturableMesh*>(mesh)->vertices[vertexID].pos = pos;
+    else
+        static_cast<PlainMesh*>(mesh)->vertices[vertexID].pos = pos;
+}
+
+void OpenGLContent::WeldVertices(Mesh* mesh, GLfloat tolerance)
+{
+    size_t nVertices = mesh->getNumOfVertices();
+    if(nVertices == 0)
+        return;
+    
+    //Spatial hashing with cells of the size of the tolerance
+    GLfloat cellSize = std::max(tolerance, 1e-9f);
+    GLfloat tol2 = tolerance * tolerance;
+    std::map<std::array<int64_t, 3>, std::vector<GLuint>> grid;
+    std::vector<GLuint> remap(nVertices);
+    
+    for(size_t i=0; i<nVertices; ++i)
+    {
+        glm::vec3 pos = mesh->getVertexPos(i);
+        std::array<int64_t, 3> cell = {(int64_t)std::floor(pos.x/cellSize), (int64_t)std::floor(pos.y/cellSize), (int64_t)std::floor(pos.z/cellSize)};
+        remap[i] = (GLuint)i;
+        
+        for(int64_t dx=-1; dx<=1 && remap[i] == i; ++dx)
+            for(int64_t dy=-1; dy<=1 && remap[i] == i; ++dy)
+                for(int64_t dz=-1; dz<=1 && remap[i] == i; ++dz)
+                {
+                    auto it = grid.find({cell[0]+dx, cell[1]+dy, cell[2]+dz});
+                    if(it == grid.end())
+                        continue;
+                    for(size_t h=0; h<it->second.size(); ++h)
+                        if(glm::length2(mesh->getVertexPos(it->second[h]) - pos) <= tol2)
+                        {
+                            remap[i] = it->second[h];
+                            break;
+                        }
+                }
+        
+        if(remap[i] == i)
+            grid[cell].push_back((GLuint)i);
+    }
+    
+    std::vector<Face> newFaces;
+    newFaces.reserve(mesh->faces.size());
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        Face f;
+        for(unsigned short k=0; k<3; ++k)
+            f.vertexID[k] = remap[mesh->faces[i].vertexID[k]];
+        if(f.vertexID[0] != f.vertexID[1] && f.vertexID[1] != f.vertexID[2] && f.vertexID[2] != f.vertexID[0])
+            newFaces.push_back(f);
+    }
+    mesh->faces.swap(newFaces);
+    CompactVertices(mesh);
+    
+#ifdef DEBUG
+    cInfo("Mesh welded (%ld/%ld vertices).", nVertices, mesh->getNumOfVertices());
+#endif
+}
+
+typedef std::array<double, 10> Quadric; //Symmetric 4x4 matrix (upper triangle)
+
+static double QuadricError(const Quadric& q, const glm::dvec3& p)
+{
+    return q[0]*p.x*p.x + 2.0*q[1]*p.x*p.y + 2.0*q[2]*p.x*p.z + 2.0*q[3]*p.x
+           + q[4]*p.y*p.y + 2.0*q[5]*p.y*p.z + 2.0*q[6]*p.y
+           + q[7]*p.z*p.z + 2.0*q[8]*p.z + q[9];
+}
+
+void OpenGLContent::Decimate(Mesh* mesh, size_t targetFaceCount, GLfloat maxError)
+{
+    size_t nVertices = mesh->getNumOfVertices();
+    size_t nFaces = mesh->faces.size();
+    if(nFaces <= targetFaceCount || nVertices < 4)
+        return;
+    
+    double maxCost = maxError > 0.f ? (double)maxError * (double)maxError : std::numeric_limits<double>::max();
+    std::vector<Face>& faces = mesh->faces;
+    std::vector<glm::dvec3> pos(nVertices);
+    std::vector<Quadric> Q(nVertices, Quadric{});
+    std::vector<std::vector<GLuint>> vertexFaces(nVertices);
+    std::vector<bool> faceAlive(nFaces, true);
+    std::vector<bool> vertexAlive(nVertices, true);
+    std::vector<unsigned int> stamp(nVertices, 0); //Invalidates outdated collapses
+    
+    for(size_t i=0; i<nVertices; ++i)
+        pos[i] = glm::dvec3(mesh->getVertexPos(i));
+    
+    //Quadrics of the planes of the original faces
+    for(size_t i=0; i<nFaces; ++i)
+    {
+        const GLuint* id = faces[i].vertexID;
+        glm::dvec3 n = glm::cross(pos[id[1]] - pos[id[0]], pos[id[2]] - pos[id[0]]);
+        double len = glm::length(n);
+        for(unsigned short k=0; k<3; ++k)
+            vertexFaces[id[k]].push_back((GLuint)i);
+        if(len < 1e-12)
+            continue;
+        n /= len;
+        double d = -glm::dot(n, pos[id[0]]);
+        Quadric fq = {n.x*n.x, n.x*n.y, n.x*n.z, n.x*d, n.y*n.y, n.y*n.z, n.y*d, n.z*n.z, n.z*d, d*d};
+        for(unsigned short k=0; k<3; ++k)
+            for(size_t h=0; h<10; ++h)
+                Q[id[k]][h] += fq[h];
+    }
+    
+    struct Collapse
+    {
+        double cost;
+        GLuint v0, v1;
+        unsigned int s0, s1;
+        glm::dvec3 p;
+        
+        bool operator<(const Collapse& other) const { return cost > other.cost; } //Cheapest on top
+    };
+    std::priority_queue<Collapse> heap;
+    
+    auto pushEdge = [&](GLuint a, GLuint b)
+    {
+        Quadric q;
+        for(size_t h=0; h<10; ++h)
+            q[h] = Q[a][h] + Q[b][h];
+        glm::dvec3 candidates[3] = {pos[a], pos[b], (pos[a] + pos[b]) * 0.5};
+        Collapse c;
+        c.cost = std::numeric_limits<double>::max();
+        for(unsigned short k=0; k<3; ++k)
+        {
+            double e = QuadricError(q, candidates[k]);
+            if(e < c.cost)
+            {
+                c.cost = e;
+                c.p = candidates[k];
+            }
+        }
+        c.cost = std::max(c.cost, 0.0);
+        c.v0 = a;
+        c.v1 = b;
+        c.s0 = stamp[a];
+        c.s1 = stamp[b];
+        heap.push(c);
+    };
+    
+    auto neighbours = [&](GLuint v, std::vector<GLuint>& out)
+    {
+        out.clear();
+        for(size_t h=0; h<vertexFaces[v].size(); ++h)
+        {
+            GLuint f = vertexFaces[v][h];
+            if(!faceAlive[f])
+                continue;
+            for(unsigned short k=0; k<3; ++k)
+                if(faces[f].vertexID[k] != v)
+                    out.push_back(faces[f].vertexID[k]);
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    };
+    
+    std::set<std::pair<GLuint, GLuint>> edges;
+    for(size_t i=0; i<nFaces; ++i)
+        for(unsigned short k=0; k<3; ++k)
+        {
+            GLuint a = faces[i].vertexID[k];
+            GLuint b = faces[i].vertexID[(k+1)%3];
+            edges.insert(std::make_pair(std::min(a, b), std::max(a, b)));
+        }
+    for(auto it = edges.begin(); it != edges.end(); ++it)
+        pushEdge(it->first, it->second);
+    edges.clear();
+    
+    size_t faceCount = nFaces;
+    std::vector<GLuint> n0, n1, common;
+    
+    while(faceCount > targetFaceCount && !heap.empty())
+    {
+        Collapse c = heap.top();
+        heap.pop();
+        if(c.cost > maxCost)
+            break;
+        if(!vertexAlive[c.v0] || !vertexAlive[c.v1] || c.s0 != stamp[c.v0] || c.s1 != stamp[c.v1])
+            continue;
+        
+        //Keep the surface manifold (link condition)
+        size_t edgeFaces = 0;
+        for(size_t h=0; h<vertexFaces[c.v0].size(); ++h)
+        {
+            const Face& f = faces[vertexFaces[c.v0][h]];
+            if(faceAlive[vertexFaces[c.v0][h]] && (f.vertexID[0] == c.v1 || f.vertexID[1] == c.v1 || f.vertexID[2] == c.v1))
+                ++edgeFaces;
+        }
+        if(edgeFaces == 0)
+            continue;
+        neighbours(c.v0, n0);
+        neighbours(c.v1, n1);
+        common.clear();
+        std::set_intersection(n0.begin(), n0.end(), n1.begin(), n1.end(), std::back_inserter(common));
+        if(common.size() > edgeFaces)
+            continue;
+        
+        //Do not flip faces
+        bool flipped = false;
+        GLuint ends[2] = {c.v0, c.v1};
+        for(unsigned short e=0; e<2 && !flipped; ++e)
+            for(size_t h=0; h<vertexFaces[ends[e]].size() && !flipped; ++h)
+            {
+                GLuint fi = vertexFaces[ends[e]][h];
+                if(!faceAlive[fi])
+                    continue;
+                glm::dvec3 p[3];
+                glm::dvec3 q[3];
+                bool hasBoth = false;
+                for(unsigned short k=0; k<3; ++k)
+                {
+                    GLuint id = faces[fi].vertexID[k];
+                    p[k] = pos[id];
+                    q[k] = (id == c.v0 || id == c.v1) ? c.p : pos[id];
+                    hasBoth = hasBoth || id == ends[1-e];
+                }
+                if(hasBoth) //Removed by the collapse
+                    continue;
+                glm::dvec3 nBefore = glm::cross(p[1]-p[0], p[2]-p[0]);
+                glm::dvec3 nAfter = glm::cross(q[1]-q[0], q[2]-q[0]);
+                flipped = glm::dot(nBefore, nAfter) <= 0.0;
+            }
+        if(flipped)
+            continue;
+        
+        //Collapse v1 into v0
+        pos[c.v0] = c.p;
+        for(size_t h=0; h<10; ++h)
+            Q[c.v0][h] += Q[c.v1][h];
+        for(size_t h=0; h<vertexFaces[c.v1].size(); ++h)
+        {
+            GLuint fi = vertexFaces[c.v1][h];
+            if(!faceAlive[fi])
+                continue;
+            Face& f = faces[fi];
+            if(f.vertexID[0] == c.v0 || f.vertexID[1] == c.v0 || f.vertexID[2] == c.v0)
+            {
+                faceAlive[fi] = false;
+                --faceCount;
+            }
+            else
+            {
+                for(unsigned short k=0; k<3; ++k)
+                    if(f.vertexID[k] == c.v1)
+                        f.vertexID[k] = c.v0;
+                vertexFaces[c.v0].push_back(fi);
+            }
+        }
+        vertexFaces[c.v1].clear();
+        vertexAlive[c.v1] = false;
+        ++stamp[c.v0];
+        ++stamp[c.v1];
+        vertexFaces[c.v0].erase(std::remove_if(vertexFaces[c.v0].begin(), vertexFaces[c.v0].end(), [&faceAlive](GLuint f) { return !faceAlive[f]; }), vertexFaces[c.v0].end());
+        
+        neighbours(c.v0, n0);
+        for(size_t h=0; h<n0.size(); ++h)
+            pushEdge(c.v0, n0[h]);
+    }
+    
+    //Store the result
+    std::vector<Face> newFaces;
+    newFaces.reserve(faceCount);
+    for(size_t i=0; i<nFaces; ++i)
+        if(faceAlive[i])
+            newFaces.push_back(faces[i]);
+    faces.swap(newFaces);
+    for(size_t i=0; i<nVertices; ++i)
+        if(vertexAlive[i])
+            SetVertexPos(mesh, i, glm::vec3(pos[i]));
+    CompactVertices(mesh);
+    
+#ifdef DEBUG
+    cInfo("Mesh decimated (%ld/%ld).", nFaces, mesh->faces.size());
+#endif
+}
     
 void OpenGLContent::AABB(Mesh* mesh, glm::vec3& min, glm::vec3& max)
 {
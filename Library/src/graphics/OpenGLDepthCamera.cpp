@@ -57,7 +57,7 @@ OpenGLDepthCamera::OpenGLDepthCamera(glm::vec3 eyePosition, glm::vec3 direction,
     linearDepthPBO = 0;
     
     SetupCamera(eyePosition, direction, cameraUp);
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
     
     GLfloat fovx = horizontalFOVDeg/180.f*M_PI;
     
@@ -136,11 +136,16 @@ void OpenGLDepthCamera::SetupCamera(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _u
     tempUp = _up;
 }
 
-void OpenGLDepthCamera::UpdateTransform()
+ViewPose OpenGLDepthCamera::getPendingPose() const
 {
-    eye = tempEye;
-    dir = tempDir;
-    up = tempUp;
+    return ViewPose{tempEye, tempDir, tempUp};
+}
+
+void OpenGLDepthCamera::UpdateTransform(const ViewPose& pose)
+{
+    eye = pose.origin;
+    dir = pose.dir;
+    up = pose.up;
     SetupCamera();
 
     //Inform camera to run callback
@@ -56,7 +56,7 @@ OpenGLFLS::OpenGLFLS(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 sonar
     fov.y = glm::radians(verticalFOVDeg);
     GLfloat hFactor = sinf(fov.x/2.f);
     viewportWidth = (GLint)ceilf(2.f*hFactor*numOfBins);
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
 
     //Calculate necessary number of camera views
     GLuint nViews = (GLuint)ceilf(horizontalFOVDeg/FLS_MAX_SINGLE_FOV);
@@ -198,9 +198,9 @@ OpenGLFLS::~OpenGLFLS()
     glDeleteTextures(2, outputTex);
 }
 
-void OpenGLFLS::UpdateTransform()
+void OpenGLFLS::UpdateTransform(const ViewPose& pose)
 {
-    OpenGLSonar::UpdateTransform();
+    OpenGLSonar::UpdateTransform(pose);
     
     if(sonar == nullptr)
         return;
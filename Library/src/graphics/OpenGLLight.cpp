@@ -94,9 +94,14 @@ void OpenGLLight::UpdatePosition(glm::vec3 p)
     tempPos = p;
 }
 
-void OpenGLLight::UpdateTransform()
+ViewPose OpenGLLight::getPendingPose() const
 {
-    pos = tempPos;
+    return ViewPose{tempPos, glm::vec3(0.f), glm::vec3(0.f)};
+}
+
+void OpenGLLight::UpdateTransform(const ViewPose& pose)
+{
+    pos = pose.origin;
 }
 
 void OpenGLLight::SwitchOn()
@@ -58,7 +58,7 @@ OpenGLMSIS::OpenGLMSIS(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 son
     noise = glm::vec2(0.f);
     fov.x = glm::radians(horizontalBeamWidthDeg);
     fov.y = glm::radians(verticalBeamWidthDeg);
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
     
     //Input shader: range + echo intensity
     //Allocate resources
@@ -172,9 +172,9 @@ OpenGLMSIS::~OpenGLMSIS()
     glDeleteTextures(2, outputTex);
 }
 
-void OpenGLMSIS::UpdateTransform()
+void OpenGLMSIS::UpdateTransform(const ViewPose& pose)
 {
-    OpenGLSonar::UpdateTransform();
+    OpenGLSonar::UpdateTransform(pose);
     
     if(sonar == nullptr)
         return;
@@ -385,6 +385,11 @@ GLfloat OpenGLOcean::ComputeWaveHeight(GLfloat x, GLfloat y)
     return 0.f;
 }
 
+void OpenGLOcean::ComputeWaveHeight(const GLfloat* xyz, GLfloat* heights, size_t count)
+{
+    memset(heights, 0, sizeof(GLfloat) * count);
+}
+
 GLuint OpenGLOcean::getWaveTexture()
 {
     return oceanTextures[3];
@@ -40,6 +40,7 @@
 #include "graphics/OpenGLLight.h"
 #include "graphics/OpenGLOceanParticles.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/TickProfiler.h"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
 #include "core/GraphicalSimulationApp.h"
@@ -49,7 +50,9 @@ namespace sf
 
 OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s), hSettings(h)
 {
-    drawingQueueMutex = SDL_CreateMutex();
+    backSnapshot = 0;
+    latestSnapshot = 1;
+    frontSnapshot = 2;
     
     //Set default OpenGL options
     cInfo("Initialising OpenGL rendering pipeline...");
@@ -93,7 +96,6 @@ OpenGLPipeline::~OpenGLPipeline()
     
     glDeleteTextures(1, &screenTex);
     glDeleteFramebuffers(1, &screenFBO);
-    SDL_DestroyMutex(drawingQueueMutex);
 }
 
 RenderSettings OpenGLPipeline::getRenderSettings() const
@@ -111,77 +113,100 @@ GLuint OpenGLPipeline::getScreenTexture()
     return screenTex;
 }
 
-SDL_mutex* OpenGLPipeline::getDrawingQueueMutex()
-{
-    return drawingQueueMutex;
-}
-    
 OpenGLContent* OpenGLPipeline::getContent()
 {
     return content;
 }
 
+void OpenGLPipeline::AddToSnapshot(std::vector<Renderable>& queue, size_t& n, const Renderable& r)
+{
+    if(n < queue.size())
+        queue[n] = r; //Reuse memory of the object from an earlier frame
+    else
+        queue.push_back(r);
+    ++n;
+}
+
 void OpenGLPipeline::AddToDrawingQueue(const Renderable& r)
 {
-    drawingQueue.push_back(r);
+    RenderSnapshot& back = snapshots[backSnapshot];
+    AddToSnapshot(back.objects, back.nObjects, r);
 }
 
 void OpenGLPipeline::AddToDrawingQueue(const std::vector<Renderable>& r)
 {
-    drawingQueue.insert(drawingQueue.end(), r.begin(), r.end());
+    RenderSnapshot& back = snapshots[backSnapshot];
+    for(size_t i=0; i<r.size(); ++i)
+        AddToSnapshot(back.objects, back.nObjects, r[i]);
 }
 
 void OpenGLPipeline::AddToSelectedDrawingQueue(const std::vector<Renderable>& r)
 {
-    selectedDrawingQueue.insert(selectedDrawingQueue.end(), r.begin(), r.end());
+    RenderSnapshot& back = snapshots[backSnapshot];
+    for(size_t i=0; i<r.size(); ++i)
+        AddToSnapshot(back.selected, back.nSelected, r[i]);
 }
 
 void OpenGLPipeline::PurgeDrawingQueue()
 {
-    drawingQueue.clear();
+    snapshots[backSnapshot].nObjects = 0;
 }
 
 void OpenGLPipeline::PurgeSelectedDrawingQueue()
 {
-    selectedDrawingQueue.clear();
+    snapshots[backSnapshot].nSelected = 0;
 }
 
-bool OpenGLPipeline::isDrawingQueueEmpty()
+void OpenGLPipeline::PublishDrawingQueue(SimulationManager* sim)
 {
-    return drawingQueue.empty();
+    RenderSnapshot& back = snapshots[backSnapshot];
+    //Objects above the count belong to earlier, bigger frames
+    back.objects.resize(back.nObjects);
+    back.selected.resize(back.nSelected);
+    //Poses set by the simulation are only read by the renderer through the snapshot
+    back.views.resize(content->getViewsCount());
+    for(size_t i=0; i<back.views.size(); ++i)
+        back.views[i] = content->getView(i)->getPendingPose();
+    back.lights.resize(content->getLightsCount());
+    for(size_t i=0; i<back.lights.size(); ++i)
+        back.lights[i] = content->getLight(i)->getPendingPose();
+    Ocean* ocean = sim->getOcean();
+    back.hasCurrents = ocean != nullptr;
+    if(back.hasCurrents)
+        back.currents = ocean->getCurrentsData();
+    //Swap with the last published snapshot (possibly not taken by the renderer)
+    backSnapshot = latestSnapshot.exchange(backSnapshot | newSnapshotFlag, std::memory_order_acq_rel) & snapshotIndexMask;
+    PurgeDrawingQueue();
+    PurgeSelectedDrawingQueue();
+}
+    
+bool OpenGLPipeline::isDrawingQueuePending() const
+{
+    return (latestSnapshot.load(std::memory_order_acquire) & newSnapshotFlag) != 0;
 }
     
 void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
 {
-    SDL_LockMutex(drawingQueueMutex);
+    //Take the last published snapshot (triple buffering, no copy, no locking)
+    if(latestSnapshot.load(std::memory_order_acquire) & newSnapshotFlag)
+    {
+        frontSnapshot = latestSnapshot.exchange(frontSnapshot, std::memory_order_acq_rel) & snapshotIndexMask;
+        //Sort objects by material to reduce uniform/texture switching
+        std::sort(snapshots[frontSnapshot].objects.begin(), snapshots[frontSnapshot].objects.end(), Renderable::SortByMaterial);
+    }
+    const RenderSnapshot& front = snapshots[frontSnapshot];
 
     //Update vision sensor transforms and copy generated data to ensure consistency
     glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT);
-    for(unsigned int i=0; i < content->getViewsCount(); ++i)
-        content->getView(i)->UpdateTransform();
+    for(size_t i=0; i < content->getViewsCount() && i < front.views.size(); ++i)
+        content->getView(i)->UpdateTransform(front.views[i]);
     //Update light transforms to ensure consistency
-    for(unsigned int i=0; i < content->getLightsCount(); ++i)
-        content->getLight(i)->UpdateTransform();
+    for(size_t i=0; i < content->getLightsCount() && i < front.lights.size(); ++i)
+        content->getLight(i)->UpdateTransform(front.lights[i]);
     //Update ocean currents for particle systems
     Ocean* ocean = sim->getOcean();
-    if(ocean != NULL) ocean->UpdateCurrentsData();
-
-    if(!drawingQueue.empty())
-    {
-        drawingQueueCopy.clear();
-        selectedDrawingQueueCopy.clear();
-        //Double buffering
-        drawingQueueCopy.insert(drawingQueueCopy.end(), drawingQueue.begin(), drawingQueue.end());
-        selectedDrawingQueueCopy.insert(selectedDrawingQueueCopy.end(), selectedDrawingQueue.begin(), selectedDrawingQueue.end());
-        //Enable update of drawing queue by clearing old queue
-        drawingQueue.clear(); 
-        selectedDrawingQueue.clear();
-    }
-
-    SDL_UnlockMutex(drawingQueueMutex);
-
-    //Sort objects by material to reduce uniform/texture switching
-    std::sort(drawingQueueCopy.begin(), drawingQueueCopy.end(), Renderable::SortByMaterial);
+    if(ocean != nullptr && front.hasCurrents) 
+        ocean->UpdateCurrentsData(front.currents);
 }
 
 void OpenGLPipeline::DrawDisplay()
@@ -193,6 +218,7 @@ void OpenGLPipeline::DrawDisplay()
 
 void OpenGLPipeline::DrawObjects()
 {
+    std::vector<Renderable>& drawingQueueCopy = snapshots[frontSnapshot].objects;
     for(size_t i=0; i<drawingQueueCopy.size(); ++i)
     {
 		if(drawingQueueCopy[i].type == RenderableType::SOLID)
@@ -208,6 +234,8 @@ void OpenGLPipeline::DrawLights()
     
 void OpenGLPipeline::DrawHelpers()
 {
+    std::vector<Renderable>& drawingQueueCopy = snapshots[frontSnapshot].objects;
+    
     //Coordinate systems
     if(hSettings.showCoordSys)
     {
@@ -331,19 +359,26 @@ void OpenGLPipeline::DrawHelpers()
 
 void OpenGLPipeline::Render(SimulationManager* sim)
 {	
+    ProfileScope scope("Render");
+    
     //Update time step for animation purposes
     Scalar now = sim->getSimulationTime();
     Scalar dt = now-lastSimTime;
     lastSimTime = now;
 
-    //Double-buffering of drawing queue
+    //Triple-buffering of drawing queue
+    TickProfiler::Begin("Drawing queue copy");
     PerformDrawingQueueCopy(sim);
+    TickProfiler::End();
+    std::vector<Renderable>& drawingQueueCopy = snapshots[frontSnapshot].objects;
+    std::vector<Renderable>& selectedDrawingQueueCopy = snapshots[frontSnapshot].selected;
 	
     //Choose rendering mode
     unsigned int renderMode = 0; //Defaults to rendering without ocean
     Ocean* ocean = sim->getOcean();
     if(ocean != NULL)
     {
+        ProfileScope oceanScope("Ocean simulation");
         ocean->getOpenGLOcean()->Simulate(dt);
         renderMode = rSettings.ocean > RenderQuality::DISABLED && ocean->isRenderable() ? 1 : 0;
     }
@@ -355,6 +390,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
     content->SetupLights();
     if(rSettings.shadows > RenderQuality::DISABLED)
     {
+        ProfileScope shadowScope("Light shadow maps");
         glCullFace(GL_FRONT);
         glDisable(GL_DEPTH_CLAMP);
         content->SetDrawingMode(DrawingMode::SHADOW);
@@ -414,6 +450,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             
         if(view->getType() == ViewType::DEPTH_CAMERA)
         {
+            ProfileScope viewScope("Depth camera");
             OpenGLDepthCamera* camera = static_cast<OpenGLDepthCamera*>(view);
             //Draw objects and compute depth data
             camera->ComputeOutput(drawingQueueCopy);
@@ -422,6 +459,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         }
         else if(view->getType() == ViewType::SONAR)
         {
+            ProfileScope viewScope("Sonar");
             OpenGLSonar* sonar = static_cast<OpenGLSonar*>(view);
             //Draw objects and compute sonar data
             sonar->ComputeOutput(drawingQueueCopy);
@@ -430,6 +468,8 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         }
         else if(view->getType() == ViewType::CAMERA || view->getType() == ViewType::TRACKBALL)
         {
+            ProfileScope viewScope(view->getType() == ViewType::TRACKBALL ? "Trackball" : "Camera");
+            
             //Apply view properties
             OpenGLCamera* camera = static_cast<OpenGLCamera*>(view);
             OpenGLLight::SetCamera(camera);
@@ -439,6 +479,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             //Bake parallel-split shadowmaps for sun
             if(rSettings.shadows > RenderQuality::DISABLED)
             {
+                ProfileScope shadowScope("Sun shadow maps");
                 content->SetDrawingMode(DrawingMode::SHADOW);
                 atm->getOpenGLAtmosphere()->BakeShadowmaps(this, camera);
             }
@@ -454,6 +495,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             content->SetCurrentView(camera);
             
             //Draw scene
+            TickProfiler::Begin("Scene");
             if(renderMode == 0) //NO OCEAN
             {
                 //Render all objects
@@ -571,12 +613,17 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                 }
             }
         
+            TickProfiler::End();
+            
             //Tone mapping
+            TickProfiler::Begin("Tone mapping");
             camera->DrawLDR(screenFBO, true);
+            TickProfiler::End();
         
             //Helper objects
             if(camera->getType() == ViewType::TRACKBALL)
             {
+                ProfileScope helperScope("Helpers");
                 //Overlay debugging info
                 OpenGLState::BindFramebuffer(screenFBO); //No depth buffer, just one color buffer
                 content->SetProjectionMatrix(camera->GetProjectionMatrix());
@@ -623,8 +670,10 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         }
     }
     //Draw views that are displayed but not updated
+    TickProfiler::Begin("Static views");
     for(size_t i=0; i<viewsNoUpdate.size(); ++i)
         content->getView(viewsNoUpdate[i])->DrawLDR(screenFBO, false);
+    TickProfiler::End();
     //Remove views drawn in this frame
     viewsQueue.erase(viewsQueue.begin(), viewsQueue.begin() + updateCount);
 }
@@ -53,7 +53,7 @@ OpenGLRealCamera::OpenGLRealCamera(glm::vec3 eyePosition, glm::vec3 direction, g
     GLfloat fovy = 2.f * atanf( (GLfloat)viewportHeight/(GLfloat)viewportWidth * tanf(fovx/2.f) );
     projection = glm::perspectiveFov(fovy, (GLfloat)viewportWidth, (GLfloat)viewportHeight, near, far);
 
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
 }
 
 OpenGLRealCamera::~OpenGLRealCamera()
@@ -130,11 +130,16 @@ void OpenGLRealCamera::SetupCamera(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up
     tempUp = _up;
 }
 
-void OpenGLRealCamera::UpdateTransform()
+ViewPose OpenGLRealCamera::getPendingPose() const
 {
-    eye = tempEye;
-    dir = tempDir;
-    up = tempUp;
+    return ViewPose{tempEye, tempDir, tempUp};
+}
+
+void OpenGLRealCamera::UpdateTransform(const ViewPose& pose)
+{
+    eye = pose.origin;
+    dir = pose.dir;
+    up = pose.up;
     SetupCamera();
     
     viewUBOData.VP = GetProjectionMatrix() * GetViewMatrix();
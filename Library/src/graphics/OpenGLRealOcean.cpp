@@ -296,6 +296,36 @@ GLfloat OpenGLRealOcean::ComputeWaveHeight(GLfloat x, GLfloat y)
     return z;
 }
 
+void OpenGLRealOcean::ComputeWaveHeight(const GLfloat* xyz, GLfloat* heights, size_t count)
+{
+    //Same as the single point version but without branches, so that it can be vectorised.
+    //Texel coordinates are wrapped with a mask (FFT size is a power of 2).
+    const int N = params.fftSize;
+    const int mask = N - 1;
+    const GLfloat s[2] = {(GLfloat)N/params.gridSizes.x, (GLfloat)N/params.gridSizes.y};
+    
+    for(size_t i=0; i<count; ++i)
+    {
+        GLfloat z = 0.f;
+        for(int c=0; c<2; ++c)
+        {
+            GLfloat u = xyz[3*i] * s[c] - 0.5f;
+            GLfloat v = xyz[3*i+1] * s[c] - 0.5f;
+            GLfloat fu = floorf(u);
+            GLfloat fv = floorf(v);
+            GLfloat alpha = u - fu;
+            GLfloat beta = v - fv;
+            int i0 = (int)fu & mask;
+            int j0 = (int)fv & mask;
+            int i1 = (i0 + 1) & mask;
+            int j1 = (j0 + 1) & mask;
+            z -= (1.f - alpha)*(1.f - beta)*fftData[(j0 * N + i0) * 4 + c] + alpha*(1.f - beta)*fftData[(j0 * N + i1) * 4 + c]
+                 + (1.f - alpha)*beta*fftData[(j1 * N + i0) * 4 + c] + alpha*beta*fftData[(j1 * N + i1) * 4 + c];
+        }
+        heights[i] = z;
+    }
+}
+
 void OpenGLRealOcean::Simulate(GLfloat dt)
 {
     if(SDL_TryLockMutex(hydroMutex) == 0)
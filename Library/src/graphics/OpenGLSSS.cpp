@@ -55,7 +55,7 @@ OpenGLSSS::OpenGLSSS(glm::vec3 centerPosition, glm::vec3 direction, glm::vec3 fo
     nBeamSamples.x = glm::min((GLuint)ceilf(verticalBeamWidthDeg * (GLfloat)numOfBins/2.f * SSS_VRES_FACTOR), (GLuint)2048);
     nBeamSamples.y = glm::min((GLuint)ceilf(horizontalBeamWidthDeg * SSS_HRES_FACTOR), (GLuint)2048);
     noise = glm::vec2(0.f);
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
     
     //Setup matrices
     GLfloat near = range.x * glm::cos(glm::max(fov.x/2.f, fov.y/2.f));
@@ -189,9 +189,9 @@ OpenGLSSS::~OpenGLSSS()
     glDeleteTextures(3, outputTex);
 }
 
-void OpenGLSSS::UpdateTransform()
+void OpenGLSSS::UpdateTransform(const ViewPose& pose)
 {
-    OpenGLSonar::UpdateTransform();
+    OpenGLSonar::UpdateTransform(pose);
 
     if(sonar == nullptr)
         return;
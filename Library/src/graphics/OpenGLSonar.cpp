@@ -75,11 +75,16 @@ void OpenGLSonar::SetupSonar(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
     tempUp = _up;
 }
 
-void OpenGLSonar::UpdateTransform()
+ViewPose OpenGLSonar::getPendingPose() const
 {
-    eye = tempEye;
-    dir = tempDir;
-    up = tempUp;
+    return ViewPose{tempEye, tempDir, tempUp};
+}
+
+void OpenGLSonar::UpdateTransform(const ViewPose& pose)
+{
+    eye = pose.origin;
+    dir = pose.dir;
+    up = pose.up;
     SetupSonar();
 }
 
@@ -73,7 +73,7 @@ OpenGLSpotLight::OpenGLSpotLight(glm::vec3 position, glm::vec3 direction, GLfloa
     
 	UpdatePosition(position);
     UpdateDirection(direction);
-    UpdateTransform();
+    UpdateTransform(getPendingPose());
 }
 
 OpenGLSpotLight::~OpenGLSpotLight()
@@ -128,10 +128,17 @@ void OpenGLSpotLight::UpdateDirection(glm::vec3 d)
     tempDir = d;
 }
     
-void OpenGLSpotLight::UpdateTransform()
+ViewPose OpenGLSpotLight::getPendingPose() const
 {
-    OpenGLLight::UpdateTransform();
-    dir = tempDir;
+    ViewPose pose = OpenGLLight::getPendingPose();
+    pose.dir = tempDir;
+    return pose;
+}
+
+void OpenGLSpotLight::UpdateTransform(const ViewPose& pose)
+{
+    OpenGLLight::UpdateTransform(pose);
+    dir = pose.dir;
 }
 
 void OpenGLSpotLight::SetupShader(LightUBO* ubo)
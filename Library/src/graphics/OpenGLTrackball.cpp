@@ -59,7 +59,7 @@ OpenGLTrackball::OpenGLTrackball(glm::vec3 centerPosition, GLfloat orbitRadius,
     outlineShader[1]->AddUniform("tex", ParameterType::INT);
     outlineShader[1]->AddUniform("invTexSize", ParameterType::VEC2);
 
-    UpdateTransform();
+    UpdateViewMatrix();
 }
 
 OpenGLTrackball::~OpenGLTrackball()
@@ -105,9 +105,19 @@ void OpenGLTrackball::UpdateCenterPos()
     }
 }
 
-void OpenGLTrackball::UpdateTransform()
+ViewPose OpenGLTrackball::getPendingPose() const
+{
+    return ViewPose{tempCenter, glm::vec3(0.f), glm::vec3(0.f)};
+}
+
+void OpenGLTrackball::UpdateTransform(const ViewPose& pose)
+{
+    if(holdingEntity != nullptr) center = pose.origin;
+    UpdateViewMatrix();
+}
+
+void OpenGLTrackball::UpdateViewMatrix()
 {
-    if(holdingEntity != nullptr) center = tempCenter;
     trackballTransform = glm::lookAt(GetEyePosition(), center, GetUpDirection());
     
     viewUBOData.VP = GetProjectionMatrix() * GetViewMatrix();
@@ -180,7 +190,7 @@ glm::mat4 OpenGLTrackball::GetViewMatrix() const
 void OpenGLTrackball::Rotate(glm::quat rot)
 {
     rotation = rotation * rot;
-    UpdateTransform();
+    UpdateViewMatrix();
 }
 
 void OpenGLTrackball::MoveCenter(glm::vec3 step)
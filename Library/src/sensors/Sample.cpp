@@ -33,8 +33,7 @@ namespace sf
 
 Sample::Sample(unsigned short nDimensions, Scalar* values, bool invalid, uint64_t index)
 {
-    nDim = nDimensions > 0 ? nDimensions : 1;
-    data = new Scalar[nDim];
+    Allocate(nDimensions > 0 ? nDimensions : 1);
     std::memcpy(data, values, sizeof(Scalar)*nDim);
     id = index;
     if(invalid)
@@ -46,15 +45,46 @@ Sample::Sample(unsigned short nDimensions, Scalar* values, bool invalid, uint64_
 Sample::Sample(const Sample& other, uint64_t index)
 {
     timestamp = other.timestamp;
-    nDim = other.nDim;
-    data = new Scalar[nDim];
+    Allocate(other.nDim);
     std::memcpy(data, other.data, sizeof(Scalar)*nDim);
     id = index;
 }
 
+Sample::Sample(Scalar timestamp, unsigned short nDimensions, const Scalar* values, uint64_t index)
+{
+    this->timestamp = timestamp;
+    Allocate(nDimensions > 0 ? nDimensions : 1);
+    std::memcpy(data, values, sizeof(Scalar)*nDim);
+    id = index;
+}
+
 Sample::~Sample()
 {
-    delete [] data;
+    if(data != localData)
+        delete [] data;
+}
+
+Sample& Sample::operator=(const Sample& other)
+{
+    if(this != &other)
+    {
+        if(other.nDim != nDim)
+        {
+            if(data != localData)
+                delete [] data;
+            Allocate(other.nDim);
+        }
+        std::memcpy(data, other.data, sizeof(Scalar)*nDim);
+        timestamp = other.timestamp;
+        id = other.id;
+    }
+    return *this;
+}
+
+void Sample::Allocate(unsigned short nDimensions)
+{
+    nDim = nDimensions;
+    data = nDim <= localCapacity ? localData : new Scalar[nDim];
 }
 
 Scalar Sample::getTimestamp() const
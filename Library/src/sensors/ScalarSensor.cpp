@@ -29,6 +29,7 @@
 #include "core/SimulationManager.h"
 #include "utils/ScientificFileUtil.h"
 #include "sensors/Sample.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -36,20 +37,23 @@ namespace sf
 ScalarSensor::ScalarSensor(std::string uniqueName, Scalar frequency, int historyLength) : Sensor(uniqueName, frequency)
 {
     historyLen = historyLength;
-    history = std::deque<Sample*>(0);
+    historyFirst = 0;
+    historyCount = 0;
     sampleCount = 0;
 }
 
 ScalarSensor::~ScalarSensor()
 {
-    ClearHistory();
     channels.clear();
 }
 
 Sample ScalarSensor::getLastSample() const
 {
-    if(history.size() > 0)
-        return Sample(*history.back());
+    if(historyCount > 0 && channels.size() > 0)
+    {
+        HistoryView view = getHistoryView();
+        return Sample(view.getTimestamp(historyCount-1), view.nChannels, view.getData(historyCount-1), sampleCount-1);
+    }
     else
     {
         unsigned short chs = getNumOfChannels();
@@ -63,15 +67,39 @@ const std::vector<Sample>* ScalarSensor::getHistory()
 {
     SDL_LockMutex(updateMutex);
     
+    HistoryView view = getHistoryView();
     std::vector<Sample>* historyCopy = new std::vector<Sample>();
-    for(size_t i=0; i<history.size(); ++i)
-        (*historyCopy).push_back(*(history[i]));
+    historyCopy->reserve(view.size());
+    for(size_t i=0; i<view.size(); ++i)
+        historyCopy->push_back(Sample(view.getTimestamp(i), view.nChannels, view.getData(i)));
     
     SDL_UnlockMutex(updateMutex);
     
     return historyCopy;
 }
 
+HistoryView ScalarSensor::getHistoryView() const
+{
+    HistoryView view;
+    view.values = historyValues.data();
+    view.timestamps = historyTimestamps.data();
+    view.capacity = historyTimestamps.size();
+    view.first = historyFirst;
+    view.count = historyCount;
+    view.nChannels = getNumOfChannels();
+    return view;
+}
+
+void ScalarSensor::LockHistory()
+{
+    SDL_LockMutex(updateMutex);
+}
+
+void ScalarSensor::UnlockHistory()
+{
+    SDL_UnlockMutex(updateMutex);
+}
+
 unsigned short ScalarSensor::getNumOfChannels() const
 {
     return channels.size();
@@ -79,19 +107,15 @@ unsigned short ScalarSensor::getNumOfChannels() const
 
 Scalar ScalarSensor::getValue(unsigned long int index, unsigned int channel) const
 {
-    if(index < history.size() && channel < channels.size())
-    {
-        Sample* s = history[index];
-        Scalar v = s->getValue(channel);
-        return v;
-    }
+    if(index < historyCount && channel < channels.size())
+        return getHistoryView().getValue(index, channel);
     
     return Scalar(0);
 }
 
 Scalar ScalarSensor::getLastValue(unsigned int channel) const
 {
-    return getValue(history.size() - 1, channel);
+    return getValue(historyCount - 1, channel);
 }
 
 SensorChannel ScalarSensor::getSensorChannelDescription(unsigned int channel) const
@@ -110,25 +134,51 @@ void ScalarSensor::Reset()
 
 void ScalarSensor::AddSampleToHistory(const Sample& s)
 {
-    if(historyLen < 0 && history.size() > 0) //No history
-    {
-        delete history[0];
-        history.pop_front();
-    }
-    else if(historyLen > 0 && (int)history.size() == historyLen) //Specified history length
+    size_t nCh = channels.size();
+    size_t capacity = historyTimestamps.size();
+    
+    if(historyCount == capacity) //Buffer full or not allocated
     {
-        delete history[0];
-        history.pop_front();
+        if(capacity == 0) //First sample --> allocate the whole buffer (number of channels known after construction)
+        {
+            if(historyLen < 0) //No history
+                capacity = 1;
+            else if(historyLen > 0) //Specified history length
+                capacity = (size_t)historyLen;
+            else //Unlimited history
+                capacity = 1024;
+            historyFirst = 0;
+        }
+        else if(historyLen == 0) //Unlimited history --> grow (oldest sample always at index 0)
+            capacity *= 2;
+        else //Drop the oldest sample
+        {
+            historyFirst = historyFirst + 1 < capacity ? historyFirst + 1 : 0;
+            --historyCount;
+        }
+        
+        if(capacity != historyTimestamps.size())
+        {
+            historyValues.resize(capacity * nCh);
+            historyTimestamps.resize(capacity);
+        }
     }
-    //else == 0 --> unlimited history
     
-    Sample* sample = new Sample(s, sampleCount);
+    size_t slot = historyFirst + historyCount;
+    if(slot >= capacity) slot -= capacity;
+    
+    Scalar* data = &historyValues[slot * nCh];
+    size_t nDim = s.getNumOfDimensions() < nCh ? s.getNumOfDimensions() : nCh;
+    for(size_t i=0; i<nDim; ++i)
+        data[i] = s.getValue(i);
+    for(size_t i=nDim; i<nCh; ++i)
+        data[i] = Scalar(0);
+    historyTimestamps[slot] = s.getTimestamp();
+    ++historyCount;
     ++sampleCount;
     
-    for(unsigned int i=0; i<sample->getNumOfDimensions(); ++i)
+    for(size_t i=0; i<nCh; ++i)
     {
-        Scalar* data = sample->getDataPointer();
-        
         //Add noise
         if(channels[i].stdDev > Scalar(0) && data[i] < channels[i].rangeMax && data[i] > channels[i].rangeMin)
             data[i] += channels[i].noise(randomGenerator);
@@ -139,24 +189,50 @@ void ScalarSensor::AddSampleToHistory(const Sample& s)
         else if(data[i] < channels[i].rangeMin)
             data[i] = channels[i].rangeMin;
     }
-    
-    //Add to history
-    history.push_back(sample);
+}
+
+void ScalarSensor::SaveState(StateBuffer& state) const
+{
+    SDL_LockMutex(updateMutex);
+    Sensor::SaveState(state);
+    state.Write(sampleCount);
+    state.Write(historyFirst);
+    state.Write(historyCount);
+    state.Write(historyValues);
+    state.Write(historyTimestamps);
+    for(size_t i=0; i<channels.size(); ++i)
+        state.Write(channels[i].noise);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void ScalarSensor::RestoreState(StateReader& state)
+{
+    SDL_LockMutex(updateMutex);
+    Sensor::RestoreState(state);
+    state.Read(sampleCount);
+    state.Read(historyFirst);
+    state.Read(historyCount);
+    state.Read(historyValues);
+    state.Read(historyTimestamps);
+    for(size_t i=0; i<channels.size(); ++i)
+        state.Read(channels[i].noise);
+    SDL_UnlockMutex(updateMutex);
 }
 
 void ScalarSensor::ClearHistory()
 {
-    for(unsigned int i = 0; i < history.size(); i++)
-        delete history[i];
-    
-    history.clear();
+    //Keep the buffer to avoid allocations when the sensor is reset
+    historyFirst = 0;
+    historyCount = 0;
 }
 
 void ScalarSensor::SaveMeasurementsToTextFile(const std::string& path, bool includeTime, unsigned int fixedPrecision)
 {
-    if(history.size() == 0)
+    if(historyCount == 0)
         return;
     
+    HistoryView view = getHistoryView();
+    
     cInfo("Saving %s measurements to: %s", getName().c_str(), path.c_str());
     
     FILE* fp = fopen(path.c_str(), "wt");
@@ -169,7 +245,7 @@ void ScalarSensor::SaveMeasurementsToTextFile(const std::string& path, bool incl
     //Write header
     fprintf(fp, "#Measurements from %s\n", getName().c_str());
     fprintf(fp, "#Number of channels: %ld\n", channels.size());
-    fprintf(fp, "#Number of samples: %ld\n", history.size());
+    fprintf(fp, "#Number of samples: %ld\n", view.size());
     if(freq <= Scalar(0.))
         fprintf(fp, "#Frequency: %1.3lf Hz\n", SimulationApp::getApp()->getSimulationManager()->getStepsPerSecond());
     else
@@ -195,19 +271,17 @@ void ScalarSensor::SaveMeasurementsToTextFile(const std::string& path, bool incl
     //Write data
     std::string format = "%1." + std::to_string(fixedPrecision) + "lf";
     
-    for(unsigned int i = 0; i < history.size(); i++)
+    for(unsigned int i = 0; i < view.size(); i++)
     {
-        Sample* s = history[i];
-        
         if(includeTime)
         {
-            fprintf(fp, format.c_str(), s->getTimestamp());
+            fprintf(fp, format.c_str(), view.getTimestamp(i));
             fprintf(fp, "\t");
         }
         
         for(unsigned int h = 0; h < channels.size(); h++)
         {
-            Scalar v = s->getValue(h);
+            Scalar v = view.getValue(i, h);
             
             fprintf(fp, format.c_str(), v);
             
@@ -223,9 +297,11 @@ void ScalarSensor::SaveMeasurementsToTextFile(const std::string& path, bool incl
 
 void ScalarSensor::SaveMeasurementsToOctaveFile(const std::string& path, bool includeTime, bool separateChannels)
 {
-    if(history.size() == 0)
+    if(historyCount == 0)
         return;
     
+    HistoryView view = getHistoryView();
+    
     //build data structure
     ScientificData data("");
     
@@ -237,14 +313,11 @@ void ScalarSensor::SaveMeasurementsToOctaveFile(const std::string& path, bool in
             it->name = "Time";
             it->type = DATA_VECTOR;
             
-            btVectorXu* vector = new btVectorXu((unsigned int)history.size());
+            btVectorXu* vector = new btVectorXu((unsigned int)view.size());
             it->value = vector;
             
-            for(unsigned int i = 0; i < history.size(); ++i)
-            {
-                Sample* s = history[i];
-                (*vector)[i] = s->getTimestamp();
-            }
+            for(unsigned int i = 0; i < view.size(); ++i)
+                (*vector)[i] = view.getTimestamp(i);
             
             data.addItem(it);
         }
@@ -256,15 +329,11 @@ void ScalarSensor::SaveMeasurementsToOctaveFile(const std::string& path, bool in
             it->name = channels[i].name;
             it->type = DATA_VECTOR;
             
-            btVectorXu* vector = new btVectorXu((unsigned int)history.size());
+            btVectorXu* vector = new btVectorXu((unsigned int)view.size());
             it->value = vector;
             
-            for(unsigned int h = 0; h < history.size(); ++h)
-            {
-                Sample* s = history[h];
-                Scalar v = s->getValue(i);
-                (*vector)[h] = v;
-            }
+            for(unsigned int h = 0; h < view.size(); ++h)
+                (*vector)[h] = view.getValue(h, i);
             
             data.addItem(it);
         }
@@ -275,19 +344,17 @@ void ScalarSensor::SaveMeasurementsToOctaveFile(const std::string& path, bool in
         it->name = getName();
         it->type = DATA_MATRIX;
         
-        btMatrixXu* matrix = new btMatrixXu((unsigned int)history.size(), (unsigned int)channels.size() + (includeTime ? 1 : 0));
+        btMatrixXu* matrix = new btMatrixXu((unsigned int)view.size(), (unsigned int)channels.size() + (includeTime ? 1 : 0));
         it->value = matrix;
         
-        for(unsigned int i = 0; i < history.size(); ++i)
+        for(unsigned int i = 0; i < view.size(); ++i)
         {
-            Sample* s = history[i];
-            
             if(includeTime)
-                matrix->setElem(i, 0, s->getTimestamp());
+                matrix->setElem(i, 0, view.getTimestamp(i));
             
             for(unsigned int h = 0; h < channels.size(); ++h)
             {
-                Scalar v = s->getValue(h);
+                Scalar v = view.getValue(i, h);
                 matrix->setElem(i, h + (includeTime ? 1 : 0), v);
             }
         }
@@ -30,13 +30,11 @@
 #include "core/Console.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
 
-std::random_device Sensor::randomDevice;
-std::mt19937 Sensor::randomGenerator(randomDevice());
-
 Sensor::Sensor(std::string uniqueName, Scalar frequency)
 {
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
@@ -46,6 +44,7 @@ Sensor::Sensor(std::string uniqueName, Scalar frequency)
     renderable = true;
     newDataAvailable = false;
     updateMutex = SDL_CreateMutex();
+    randomGenerator.seed(0); //Reseeded by the simulation manager when the sensor is added
     lookId = -1;
     graObjectId = -1;
 }
@@ -92,6 +91,16 @@ void Sensor::setUpdateFrequency(Scalar f)
     freq = f;
 }
 
+void Sensor::setRandomSeed(unsigned int seed)
+{
+    randomGenerator.seed(seed);
+}
+
+std::vector<Sensor*> Sensor::getDependencies() const
+{
+    return std::vector<Sensor*>(0);
+}
+
 void Sensor::setEnabled(bool en)
 {
     enabled = en;
@@ -116,6 +125,20 @@ void Sensor::setVisual(const std::string& meshFilename, Scalar scale, const std:
     delete mesh;
 }
 
+void Sensor::SaveState(StateBuffer& state) const
+{
+    state.Write(eleapsedTime);
+    state.Write(newDataAvailable);
+    state.Write(randomGenerator);
+}
+
+void Sensor::RestoreState(StateReader& state)
+{
+    state.Read(eleapsedTime);
+    state.Read(newDataAvailable);
+    state.Read(randomGenerator);
+}
+
 void Sensor::Reset()
 {
     eleapsedTime = Scalar(0.);
@@ -29,6 +29,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/MovingEntity.h"
+#include "entities/statics/Terrain.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
 
@@ -53,6 +54,7 @@ DVL::DVL(std::string uniqueName, Scalar beamAngleDeg, bool beamPositiveZ, Scalar
     addNoiseStdDev[0] = addNoiseStdDev[1] = Scalar(0);
     mulNoiseFactor[0] = mulNoiseFactor[1] = Scalar(0);
     setWaterLayer(0, 0, 0);
+    seabed = nullptr;
 }
 
 void DVL::setWaterLayer(Scalar minSize, Scalar nearBoundary, Scalar farBoundary)
@@ -62,6 +64,19 @@ void DVL::setWaterLayer(Scalar minSize, Scalar nearBoundary, Scalar farBoundary)
     waterLayer.setZ(btClamped(farBoundary, waterLayer.getX() + waterLayer.getY(), channels[3].rangeMax));
 }
     
+void DVL::setSeabed(Terrain* terrain)
+{
+    seabed = terrain;
+}
+
+void DVL::CastBeams()
+{
+    if(seabed != nullptr)
+        seabed->RayTest(rays, hits);
+    else
+        SimulationApp::getApp()->getSimulationManager()->RayTest(rays, hits);
+}
+
 void DVL::InternalUpdate(Scalar dt)
 {
     /*
@@ -88,36 +103,28 @@ void DVL::InternalUpdate(Scalar dt)
     
     Scalar dirFactor = beamPosZ ? Scalar(1) : Scalar(-1);
 
-    unsigned int divs = ceil(channels[3].rangeMax - channels[3].rangeMin);
+    SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
     Scalar minRange(-1);
 
+    //Each beam resolved with a single ray (closest hit in the operating range)
+    rays.Clear();
     for(unsigned int i=0; i<4; ++i)
     {
         from[i] = dvlTrans.getOrigin() + dirFactor * dir[i] * channels[3].rangeMin;
         to[i] = dvlTrans.getOrigin() + dirFactor * dir[i] * channels[3].rangeMax;
+        rays.AddRay(from[i], to[i]);
+    }
+    CastBeams();
 
-        Vector3 step = (to[i]-from[i])/Scalar(divs);
+    for(unsigned int i=0; i<4; ++i)
+    {
         range[i] = Scalar(-1);
-
-        for(unsigned int h=0; h<divs; ++h)
+        if(hits.hasHit(i))
         {
-            Vector3 from_ = from[i] + step*Scalar(h);
-            Vector3 to_ = from[i] + step*Scalar(h+1);
-            btCollisionWorld::ClosestRayResultCallback closest(from_, to_);
-            closest.m_collisionFilterGroup = MASK_DYNAMIC;
-            closest.m_collisionFilterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING;
-            SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from_, to_, closest);
-            
-            if(closest.hasHit())
-            {
-                Vector3 p = from_.lerp(to_, closest.m_closestHitFraction);
-                range[i] = (p - dvlTrans.getOrigin()).length();
-                break;
-            }
+            Vector3 p = from[i].lerp(to[i], hits.fraction[i]);
+            range[i] = (p - dvlTrans.getOrigin()).length();
+            if(range[i] < minRange || minRange < Scalar(0)) minRange = range[i];
         }
-
-        if(range[i] > Scalar(0) && (range[i] < minRange || minRange < Scalar(0)))
-                minRange = range[i];
     }
 
     //Get altitude
@@ -129,19 +136,21 @@ void DVL::InternalUpdate(Scalar dt)
     bool tooClose = false;
     if(minRange < Scalar(0)) //No hit recorded in DVL operating range
     {
+        rays.Clear();
         for(unsigned int i=0; i<4; ++i)
         {
-            range[i] = Scalar(-1);
             from[i] = dvlTrans.getOrigin() + dirFactor * dir[i] * channels[3].rangeMin;
             to[i] = dvlTrans.getOrigin();
-            btCollisionWorld::ClosestRayResultCallback closest(from[i], to[i]);
-            closest.m_collisionFilterGroup = MASK_DYNAMIC;
-            closest.m_collisionFilterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING;
-            SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from[i], to[i], closest);
-            
-            if(closest.hasHit() && btDot(closest.m_hitNormalWorld, dirFactor * dir[i]) > Scalar(0))
+            rays.AddRay(from[i], to[i]);
+        }
+        CastBeams();
+        
+        for(unsigned int i=0; i<4; ++i)
+        {
+            range[i] = Scalar(-1);
+            if(hits.hasHit(i) && btDot(hits.normal[i], dirFactor * dir[i]) > Scalar(0))
             {
-                Vector3 p = from[i].lerp(to[i], closest.m_closestHitFraction);
+                Vector3 p = from[i].lerp(to[i], hits.fraction[i]);
                 range[i] = (p - dvlTrans.getOrigin()).length();
                 if(range[i] < minRange || minRange < Scalar(0)) minRange = range[i];
             }
@@ -164,7 +173,7 @@ void DVL::InternalUpdate(Scalar dt)
     //ASSUME: Water layer far boundary has to be closer than 80% of altitude.
     if(!tooClose && waterLayer.getX() > Scalar(0) && Scalar(0.8)*altitude > waterLayer.getX() + waterLayer.getY()) //Water layer ping possible
     {
-        Ocean* ocn = SimulationApp::getApp()->getSimulationManager()->getOcean();
+        Ocean* ocn = sm->getOcean();
         if(ocn != nullptr)
         {
             Vector3 zDir = dvlTrans.getBasis().getColumn(2);
@@ -29,6 +29,7 @@
 #include "entities/FeatherstoneEntity.h"
 #include "sensors/Sample.h"
 #include "joints/Joint.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -57,6 +58,18 @@ Transform ForceTorque::getSensorFrame() const
     return lastFrame;
 }
 
+void ForceTorque::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(lastFrame);
+}
+
+void ForceTorque::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(lastFrame);
+}
+
 void ForceTorque::InternalUpdate(Scalar dt)
 {
     if(j != NULL && attach != NULL)
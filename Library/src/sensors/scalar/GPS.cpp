@@ -30,6 +30,7 @@
 #include "core/NED.h"
 #include "entities/forcefields/Ocean.h"
 #include "sensors/Sample.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -43,6 +44,18 @@ GPS::GPS(std::string uniqueName, Scalar frequency, int historyLength) : LinkSens
     setNoise(Scalar(0));
 }
 
+void GPS::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(noise);
+}
+
+void GPS::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(noise);
+}
+
 void GPS::InternalUpdate(Scalar dt)
 {
     //get sensor frame in world
@@ -29,6 +29,7 @@
 #include "sensors/Sample.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -49,6 +50,18 @@ IMU::IMU(std::string uniqueName, Scalar frequency, int historyLength) : LinkSens
     accumulatedYawDrift = Scalar(0);
 }
 
+void IMU::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(accumulatedYawDrift);
+}
+
+void IMU::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(accumulatedYawDrift);
+}
+
 void IMU::InternalUpdate(Scalar dt)
 {
     //get sensor frame in world
@@ -30,6 +30,7 @@
 #include "core/NED.h"
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -72,6 +73,40 @@ void INS::Reset()
     SimulationApp::getApp()->getSimulationManager()->getNED()->Ned2Geodetic(0.0, 0.0, 0.0, latitude, longitude, height);
 }
 
+void INS::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(latitude);
+    state.Write(longitude);
+    state.Write(altitude);
+    state.Write(ned);
+    state.Write(velocity);
+    state.Write(out);
+    state.Write(accNoiseX);
+    state.Write(accNoiseY);
+    state.Write(accNoiseZ);
+    state.Write(avNoiseX);
+    state.Write(avNoiseY);
+    state.Write(avNoiseZ);
+}
+
+void INS::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(latitude);
+    state.Read(longitude);
+    state.Read(altitude);
+    state.Read(ned);
+    state.Read(velocity);
+    state.Read(out);
+    state.Read(accNoiseX);
+    state.Read(accNoiseY);
+    state.Read(accNoiseZ);
+    state.Read(avNoiseX);
+    state.Read(avNoiseY);
+    state.Read(avNoiseZ);
+}
+
 void INS::InternalUpdate(Scalar dt)
 {
     Scalar now = SimulationApp::getApp()->getSimulationManager()->getSimulationTime();
@@ -228,6 +263,20 @@ void INS::setNoise(Vector3 angularVelocityStdDev, Vector3 linearAccelerationStdD
     imuNoise = true;
 }
 
+std::vector<Sensor*> INS::getDependencies() const
+{
+    std::vector<Sensor*> deps;
+    SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+    std::string names[3] = {dvlName, gpsName, pressName};
+    for(size_t i=0; i<3; ++i)
+    {
+        Sensor* s;
+        if(names[i] != "" && (s = sm->getSensor(names[i])) != nullptr)
+            deps.push_back(s);
+    }
+    return deps;
+}
+
 ScalarSensorType INS::getScalarSensorType() const
 {
     return ScalarSensorType::INS;
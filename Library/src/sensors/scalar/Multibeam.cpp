@@ -57,21 +57,20 @@ void Multibeam::InternalUpdate(Scalar dt)
     //get sensor frame in world
     Transform mbTrans = getSensorFrame();
     
-    //shoot rays
+    //shoot rays (batch)
+    rays.Clear();
     for(unsigned int i=0; i<=angSteps; ++i)
     {
         Vector3 dir = mbTrans.getBasis().getColumn(0) * btCos(angles[i]) + mbTrans.getBasis().getColumn(1) * btSin(angles[i]);
-        Vector3 from = mbTrans.getOrigin() + dir * channels[1].rangeMin;
-        Vector3 to = mbTrans.getOrigin() + dir * channels[1].rangeMax;
+        rays.AddRay(mbTrans.getOrigin() + dir * channels[i].rangeMin, mbTrans.getOrigin() + dir * channels[i].rangeMax);
+    }
+    SimulationApp::getApp()->getSimulationManager()->RayTest(rays, hits);
     
-        btCollisionWorld::ClosestRayResultCallback closest(from, to);
-        closest.m_collisionFilterGroup = MASK_DYNAMIC;
-        closest.m_collisionFilterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING;
-        SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from, to, closest);
-        
-        if(closest.hasHit())
+    for(unsigned int i=0; i<=angSteps; ++i)
+    {
+        if(hits.hasHit(i))
         {
-            Vector3 p = from.lerp(to, closest.m_closestHitFraction);
+            Vector3 p = rays.from[i].lerp(rays.to[i], hits.fraction[i]);
             distances[i] = (p - mbTrans.getOrigin()).length();
         }
         else
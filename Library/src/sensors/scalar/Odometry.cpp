@@ -27,6 +27,7 @@
 
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -50,6 +51,18 @@ Odometry::Odometry(std::string uniqueName, Scalar frequency, int historyLength)
     ornNoise = std::normal_distribution<Scalar>(Scalar(0), ornStdDev);
 }
 
+void Odometry::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(ornNoise);
+}
+
+void Odometry::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(ornNoise);
+}
+
 void Odometry::InternalUpdate(Scalar dt)
 {
     //Calculate transformation from global to imu frame
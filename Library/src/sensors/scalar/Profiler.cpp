@@ -31,6 +31,7 @@
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLContent.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -48,6 +49,20 @@ Profiler::Profiler(std::string uniqueName, Scalar angleRangeDeg, unsigned int an
     clockwise = true;
 }
     
+void Profiler::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(currentAngStep);
+    state.Write(clockwise);
+}
+
+void Profiler::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(currentAngStep);
+    state.Read(clockwise);
+}
+
 void Profiler::InternalUpdate(Scalar dt)
 {
     Transform profTrans = getSensorFrame();
@@ -55,17 +70,13 @@ void Profiler::InternalUpdate(Scalar dt)
     
     //Simulate 1 beam rotating profiler
     Vector3 dir = profTrans.getBasis().getColumn(0) * btCos(currentAngle) + profTrans.getBasis().getColumn(1) * btSin(currentAngle);
-    Vector3 from = profTrans.getOrigin() + dir * channels[1].rangeMin;
-    Vector3 to = profTrans.getOrigin() + dir * channels[1].rangeMax;
-    
-    btCollisionWorld::ClosestRayResultCallback closest(from, to);
-    closest.m_collisionFilterGroup = MASK_DYNAMIC;
-    closest.m_collisionFilterMask = MASK_STATIC | MASK_DYNAMIC | MASK_ANIMATED_COLLIDING;
-    SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from, to, closest);
+    rays.Clear();
+    rays.AddRay(profTrans.getOrigin() + dir * channels[1].rangeMin, profTrans.getOrigin() + dir * channels[1].rangeMax);
+    SimulationApp::getApp()->getSimulationManager()->RayTest(rays, hits);
         
-    if(closest.hasHit())
+    if(hits.hasHit(0))
     {
-        Vector3 p = from.lerp(to, closest.m_closestHitFraction);
+        Vector3 p = rays.from[0].lerp(rays.to[0], hits.fraction[0]);
         distance = (p - profTrans.getOrigin()).length();
     }
     else
@@ -31,6 +31,7 @@
 #include "entities/FeatherstoneEntity.h"
 #include "actuators/Motor.h"
 #include "actuators/Thruster.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -114,6 +115,20 @@ Scalar RotaryEncoder::GetRawAngularVelocity()
         return Scalar(0);
 }
 
+void RotaryEncoder::SaveState(StateBuffer& state) const
+{
+    ScalarSensor::SaveState(state);
+    state.Write(angle);
+    state.Write(lastAngle);
+}
+
+void RotaryEncoder::RestoreState(StateReader& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(angle);
+    state.Read(lastAngle);
+}
+
 void RotaryEncoder::InternalUpdate(Scalar dt)
 {
     //new angle
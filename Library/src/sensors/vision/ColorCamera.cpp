@@ -75,7 +75,7 @@ void ColorCamera::InitGraphics()
     glCamera = new OpenGLRealCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0), 0, 0, resX, resY, (GLfloat)fovH, depthRange, freq < Scalar(0));
     glCamera->setCamera(this);
     UpdateTransform();
-    glCamera->UpdateTransform();
+    glCamera->UpdateTransform(glCamera->getPendingPose());
     InternalUpdate(0);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
 }
@@ -80,7 +80,7 @@ void DepthCamera::InitGraphics()
     glCamera->setNoise(noiseStdDev);
     glCamera->setCamera(this);
     UpdateTransform();
-    glCamera->UpdateTransform();
+    glCamera->UpdateTransform(glCamera->getPendingPose());
     InternalUpdate(0);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
 }
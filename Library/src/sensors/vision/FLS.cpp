@@ -129,7 +129,7 @@ void FLS::InitGraphics()
     glFLS->setSonar(this);
     glFLS->setColorMap(cMap);
     UpdateTransform();
-    glFLS->UpdateTransform();
+    glFLS->UpdateTransform(glFLS->getPendingPose());
     InternalUpdate(0);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glFLS);
 
@@ -29,6 +29,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLMSIS.h"
+#include "utils/StateBuffer.h"
 
 namespace sf
 {
@@ -171,7 +172,7 @@ void MSIS::InitGraphics()
     glMSIS->setSonar(this);
     glMSIS->setColorMap(cMap);
     UpdateTransform();
-    glMSIS->UpdateTransform();
+    glMSIS->UpdateTransform(glMSIS->getPendingPose());
     InternalUpdate(0);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glMSIS);
 
@@ -232,6 +233,20 @@ void MSIS::NewDataReady(void* data, unsigned int index)
     }
 }
 
+void MSIS::SaveState(StateBuffer& state) const
+{
+    Camera::SaveState(state);
+    state.Write(currentStep);
+    state.Write(cw);
+}
+
+void MSIS::RestoreState(StateReader& state)
+{
+    Camera::RestoreState(state);
+    state.Read(currentStep);
+    state.Read(cw);
+}
+
 void MSIS::InternalUpdate(Scalar dt)
 {
     if(glMSIS != nullptr)
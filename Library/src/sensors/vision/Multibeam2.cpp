@@ -153,7 +153,7 @@ void Multibeam2::InitGraphics()
     
     for(size_t i=0; i<cameras.size(); ++i)
     {
-        cameras[i].cam->UpdateTransform();
+        cameras[i].cam->UpdateTransform(cameras[i].cam->getPendingPose());
         cameras[i].cam->Update();
         ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(cameras[i].cam);
     }
@@ -128,7 +128,7 @@ void SSS::InitGraphics()
     glSSS->setSonar(this);
     glSSS->setColorMap(cMap);
     UpdateTransform();
-    glSSS->UpdateTransform();
+    glSSS->UpdateTransform(glSSS->getPendingPose());
     InternalUpdate(0);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glSSS);
 
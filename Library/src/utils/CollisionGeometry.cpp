@@ -0,0 +1,411 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  CollisionGeometry.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "utils/CollisionGeometry.h"
+
+#include <algorithm>
+#include <filesystem>
+#include "LinearMath/btConvexHullComputer.h"
+#include "core/SimulationApp.h"
+#include "utils/SystemUtil.hpp"
+#include "utils/GeometryFileUtil.h"
+
+namespace sf
+{
+
+struct HullData
+{
+    std::vector<Vector3> vertices;
+    std::vector<Vector3> normals; //Outward face normals
+    std::vector<Scalar> offsets; //Plane offsets (n.p + d = 0)
+    Scalar volume;
+};
+
+struct HullCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t keyLength;
+    uint32_t nHulls;
+};
+
+static const uint32_t hullCacheVersion = 1;
+
+static void ComputeHullData(const std::vector<Vector3>& points, HullData& hull)
+{
+    hull.vertices.clear();
+    hull.normals.clear();
+    hull.offsets.clear();
+    hull.volume = Scalar(0);
+    if(points.size() < 4)
+    {
+        hull.vertices = points;
+        return;
+    }
+    
+    btConvexHullComputer chc;
+    chc.compute(&points[0].m_floats[0], sizeof(Vector3), (int)points.size(), Scalar(0), Scalar(0));
+    hull.vertices.resize(chc.vertices.size());
+    Vector3 centroid = V0();
+    for(int i=0; i<chc.vertices.size(); ++i)
+    {
+        hull.vertices[i] = chc.vertices[i];
+        centroid += chc.vertices[i];
+    }
+    if(hull.vertices.empty())
+        return;
+    centroid /= Scalar(hull.vertices.size());
+    
+    for(int i=0; i<chc.faces.size(); ++i)
+    {
+        const btConvexHullComputer::Edge* firstEdge = &chc.edges[chc.faces[i]];
+        const btConvexHullComputer::Edge* edge = firstEdge->getNextEdgeOfFace();
+        const Vector3& a = chc.vertices[firstEdge->getSourceVertex()];
+        Vector3 n = V0();
+        while(edge->getTargetVertex() != firstEdge->getSourceVertex())
+        {
+            const Vector3& b = chc.vertices[edge->getSourceVertex()];
+            const Vector3& c = chc.vertices[edge->getTargetVertex()];
+            Vector3 tn = (b - a).cross(c - a);
+            hull.volume += btFabs(tn.dot(a - centroid))/Scalar(6);
+            n += tn;
+            edge = edge->getNextEdgeOfFace();
+        }
+        if(n.fuzzyZero())
+            continue;
+        n.normalize();
+        if(n.dot(a - centroid) < Scalar(0))
+            n = -n;
+        hull.normals.push_back(n);
+        hull.offsets.push_back(-n.dot(a));
+    }
+}
+
+static Scalar ComputeConcavity(const std::vector<Vector3>& points, const HullData& hull)
+{
+    if(hull.normals.empty())
+        return Scalar(0);
+    Scalar concavity(0);
+    for(size_t i=0; i<points.size(); ++i)
+    {
+        Scalar depth(BT_LARGE_FLOAT);
+        for(size_t h=0; h<hull.normals.size(); ++h)
+            depth = btMin(depth, -(hull.normals[h].dot(points[i]) + hull.offsets[h]));
+        concavity = btMax(concavity, depth);
+    }
+    return concavity;
+}
+
+std::vector<Vector3> ComputeConvexHull(const std::vector<Vector3>& points, unsigned int maxVertices)
+{
+    HullData hull;
+    ComputeHullData(points, hull);
+    if(maxVertices == 0 || hull.vertices.size() <= maxVertices)
+        return hull.vertices;
+    
+    //Keep the support points in evenly distributed directions (Fibonacci sphere)
+    maxVertices = std::max(maxVertices, 4u);
+    const Scalar goldenAngle = Scalar(M_PI) * (Scalar(3) - btSqrt(Scalar(5)));
+    std::vector<bool> kept(hull.vertices.size(), false);
+    std::vector<Vector3> reduced;
+    for(unsigned int i=0; i<maxVertices; ++i)
+    {
+        Scalar z = Scalar(1) - Scalar(2*i+1)/Scalar(maxVertices);
+        Scalar r = btSqrt(btMax(Scalar(1) - z*z, Scalar(0)));
+        Vector3 dir(r * btCos(goldenAngle * i), r * btSin(goldenAngle * i), z);
+        
+        size_t best = 0;
+        Scalar bestDot(-BT_LARGE_FLOAT);
+        for(size_t h=0; h<hull.vertices.size(); ++h)
+        {
+            Scalar d = dir.dot(hull.vertices[h]);
+            if(d > bestDot)
+            {
+                bestDot = d;
+                best = h;
+            }
+        }
+        if(!kept[best])
+        {
+            kept[best] = true;
+            reduced.push_back(hull.vertices[best]);
+        }
+    }
+    return reduced;
+}
+
+std::vector<std::vector<Vector3>> ComputeConvexDecomposition(const Mesh* mesh, unsigned int maxHulls, Scalar maxConcavity, unsigned int maxHullVertices)
+{
+    struct Part
+    {
+        std::vector<GLuint> faces;
+        std::vector<Vector3> points;
+        HullData hull;
+        Scalar concavity;
+    };
+    
+    std::vector<Vector3> centroids(mesh->faces.size());
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        glm::vec3 c = (mesh->getVertexPos(i, 0) + mesh->getVertexPos(i, 1) + mesh->getVertexPos(i, 2))/3.f;
+        centroids[i] = Vector3(c.x, c.y, c.z);
+    }
+    
+    std::vector<bool> used(mesh->getNumOfVertices(), false);
+    auto makePart = [&](Part& part, bool withConcavity)
+    {
+        part.points.clear();
+        for(size_t i=0; i<part.faces.size(); ++i)
+            for(unsigned short k=0; k<3; ++k)
+            {
+                GLuint id = mesh->faces[part.faces[i]].vertexID[k];
+                if(!used[id])
+                {
+                    used[id] = true;
+                    glm::vec3 pos = mesh->getVertexPos(id);
+                    part.points.push_back(Vector3(pos.x, pos.y, pos.z));
+                }
+            }
+        for(size_t i=0; i<part.faces.size(); ++i)
+            for(unsigned short k=0; k<3; ++k)
+                used[mesh->faces[part.faces[i]].vertexID[k]] = false;
+        ComputeHullData(part.points, part.hull);
+        part.concavity = withConcavity ? ComputeConcavity(part.points, part.hull) : Scalar(0);
+    };
+    
+    std::vector<Part> parts(1);
+    parts[0].faces.resize(mesh->faces.size());
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+        parts[0].faces[i] = (GLuint)i;
+    makePart(parts[0], true);
+    
+    const unsigned int nSplits = 7; //Candidate planes per axis
+    while(parts.size() < maxHulls)
+    {
+        size_t worst = 0;
+        for(size_t i=1; i<parts.size(); ++i)
+            if(parts[i].concavity > parts[worst].concavity)
+                worst = i;
+        if(parts[worst].concavity <= maxConcavity)
+            break;
+        
+        //Find the split minimising the total volume of the hulls
+        Vector3 aabbMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        Vector3 aabbMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+        for(size_t i=0; i<parts[worst].faces.size(); ++i)
+        {
+            aabbMin.setMin(centroids[parts[worst].faces[i]]);
+            aabbMax.setMax(centroids[parts[worst].faces[i]]);
+        }
+        
+        Part best[2];
+        Scalar bestVolume(BT_LARGE_FLOAT);
+        for(int axis=0; axis<3; ++axis)
+            for(unsigned int s=1; s<=nSplits; ++s)
+            {
+                Scalar plane = aabbMin[axis] + (aabbMax[axis] - aabbMin[axis]) * Scalar(s)/Scalar(nSplits+1);
+                Part cand[2];
+                for(size_t i=0; i<parts[worst].faces.size(); ++i)
+                {
+                    GLuint f = parts[worst].faces[i];
+                    cand[centroids[f][axis] < plane ? 0 : 1].faces.push_back(f);
+                }
+                if(cand[0].faces.empty() || cand[1].faces.empty())
+                    continue;
+                makePart(cand[0], false);
+                makePart(cand[1], false);
+                Scalar volume = cand[0].hull.volume + cand[1].hull.volume;
+                if(volume < bestVolume)
+                {
+                    bestVolume = volume;
+                    best[0] = std::move(cand[0]);
+                    best[1] = std::move(cand[1]);
+                }
+            }
+        
+        if(best[0].faces.empty()) //Could not be split
+        {
+            parts[worst].concavity = Scalar(0);
+            continue;
+        }
+        best[0].concavity = ComputeConcavity(best[0].points, best[0].hull);
+        best[1].concavity = ComputeConcavity(best[1].points, best[1].hull);
+        parts[worst] = std::move(best[0]);
+        parts.push_back(std::move(best[1]));
+    }
+    
+    std::vector<std::vector<Vector3>> hulls;
+    for(size_t i=0; i<parts.size(); ++i)
+        if(parts[i].hull.vertices.size() >= 4)
+            hulls.push_back(ComputeConvexHull(parts[i].hull.vertices, maxHullVertices));
+    return hulls;
+}
+
+static bool ReadHullCache(const std::string& filename, const std::string& key, std::vector<std::vector<Vector3>>& hulls)
+{
+    std::error_code ec;
+    uint64_t remaining = (uint64_t)std::filesystem::file_size(filename, ec);
+    if(ec)
+        return false;
+    
+    FILE* file = fopen(filename.c_str(), "rb");
+    if(file == NULL)
+        return false;
+    
+    //Counts read from the file are checked against its size, so a corrupted file is a cache miss and not a huge allocation
+    HullCacheHeader h;
+    bool ok = remaining >= sizeof(HullCacheHeader)
+              && fread(&h, sizeof(HullCacheHeader), 1, file) == 1
+              && memcmp(h.magic, "SFCH", 4) == 0
+              && h.version == hullCacheVersion
+              && h.keyLength == key.size();
+    if(ok)
+    {
+        remaining -= sizeof(HullCacheHeader);
+        std::string storedKey(h.keyLength, '\0');
+        ok = h.keyLength <= remaining && fread(&storedKey[0], 1, h.keyLength, file) == h.keyLength && storedKey == key;
+        remaining -= ok ? h.keyLength : 0;
+        ok = ok && (uint64_t)h.nHulls * sizeof(uint32_t) <= remaining;
+    }
+    hulls.clear();
+    for(uint32_t i=0; ok && i<h.nHulls; ++i)
+    {
+        uint32_t n;
+        ok = fread(&n, sizeof(uint32_t), 1, file) == 1;
+        remaining -= ok ? sizeof(uint32_t) : 0;
+        ok = ok && (uint64_t)n * 3 * sizeof(double) <= remaining;
+        remaining -= ok ? (uint64_t)n * 3 * sizeof(double) : 0;
+        std::vector<double> coords(ok ? (size_t)n*3 : 0);
+        ok = ok && fread(coords.data(), sizeof(double), coords.size(), file) == coords.size();
+        if(ok)
+        {
+            hulls.push_back(std::vector<Vector3>(n));
+            for(uint32_t k=0; k<n; ++k)
+                hulls.back()[k] = Vector3(coords[k*3], coords[k*3+1], coords[k*3+2]);
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+static void WriteHullCache(const std::string& filename, const std::string& key, const std::vector<std::vector<Vector3>>& hulls)
+{
+    HullCacheHeader h;
+    memcpy(h.magic, "SFCH", 4);
+    h.version = hullCacheVersion;
+    h.keyLength = (uint32_t)key.size();
+    h.nHulls = (uint32_t)hulls.size();
+    
+    std::string tmpFilename = filename + "." + std::to_string(GetTimeInNanoseconds()) + ".tmp";
+    FILE* file = fopen(tmpFilename.c_str(), "wb");
+    if(file == NULL)
+    {
+        cWarning("Failed to write collision geometry cache file: %s", filename.c_str());
+        return;
+    }
+    
+    bool ok = fwrite(&h, sizeof(HullCacheHeader), 1, file) == 1
+              && fwrite(key.data(), 1, key.size(), file) == key.size();
+    for(size_t i=0; ok && i<hulls.size(); ++i)
+    {
+        uint32_t n = (uint32_t)hulls[i].size();
+        std::vector<double> coords(n*3);
+        for(uint32_t k=0; k<n; ++k)
+            for(int j=0; j<3; ++j)
+                coords[k*3+j] = hulls[i][k][j];
+        ok = fwrite(&n, sizeof(uint32_t), 1, file) == 1
+             && fwrite(coords.data(), sizeof(double), coords.size(), file) == coords.size();
+    }
+    fclose(file);
+    
+    std::error_code ec;
+    if(ok)
+        std::filesystem::rename(tmpFilename, filename, ec);
+    if(!ok || ec)
+    {
+        std::filesystem::remove(tmpFilename, ec);
+        cWarning("Failed to write collision geometry cache file: %s", filename.c_str());
+    }
+}
+
+std::vector<std::vector<Vector3>> BuildCollisionHulls(const Mesh* mesh, const CollisionGeometrySettings& settings, const std::string& cacheKey)
+{
+    std::vector<std::vector<Vector3>> hulls;
+    std::string key;
+    std::string cacheFilename;
+    if(cacheKey != "")
+    {
+        char params[128];
+        snprintf(params, 128, "@%d@%u@%u@%.17g", (int)settings.type, settings.maxHullVertices, settings.maxHulls, (double)settings.maxConcavity);
+        key = cacheKey + std::string(params);
+        cacheFilename = GetMeshCacheFilename(key, "sfhull");
+        if(cacheFilename != "" && ReadHullCache(cacheFilename, key, hulls))
+            return hulls;
+    }
+    
+    if(settings.type == CollisionGeometryType::CONVEX_DECOMPOSITION && settings.maxHulls > 1)
+    {
+        int64_t start = GetTimeInMicroseconds();
+        hulls = ComputeConvexDecomposition(mesh, settings.maxHulls, settings.maxConcavity, settings.maxHullVertices);
+        cInfo("Convex decomposition computed in %1.3lf s (%ld parts).", (double)(GetTimeInMicroseconds() - start)/1e6, hulls.size());
+    }
+    
+    if(hulls.empty()) //Single hull or failed decomposition
+    {
+        std::vector<Vector3> points(mesh->getNumOfVertices());
+        for(size_t i=0; i<points.size(); ++i)
+        {
+            glm::vec3 pos = mesh->getVertexPos(i);
+            points[i] = Vector3(pos.x, pos.y, pos.z);
+        }
+        hulls.push_back(ComputeConvexHull(points, settings.maxHullVertices));
+    }
+    
+    if(cacheFilename != "")
+        WriteHullCache(cacheFilename, key, hulls);
+    return hulls;
+}
+
+btCollisionShape* CreateConvexCollisionShape(const std::vector<std::vector<Vector3>>& hulls)
+{
+    if(hulls.size() == 1)
+    {
+        btConvexHullShape* convex = new btConvexHullShape(hulls[0].empty() ? nullptr : &hulls[0][0].m_floats[0], (int)hulls[0].size(), sizeof(Vector3));
+        convex->setMargin(0);
+        return convex;
+    }
+    
+    btCompoundShape* compound = new btCompoundShape();
+    for(size_t i=0; i<hulls.size(); ++i)
+    {
+        btConvexHullShape* convex = new btConvexHullShape(&hulls[i][0].m_floats[0], (int)hulls[i].size(), sizeof(Vector3));
+        convex->setMargin(0);
+        compound->addChildShape(I4(), convex);
+    }
+    return compound;
+}
+
+}
@@ -26,14 +26,58 @@
 #include "utils/GeometryFileUtil.h"
 
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <filesystem>
 #include "core/SimulationApp.h"
+#include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
 
 namespace sf
 {
 
+static bool geometryCacheEnabled = false;
+static std::map<std::string, Mesh*> geometryCache;
+static std::mutex geometryCacheMutex;
+
+void EnableGeometryCache(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    geometryCacheEnabled = enabled;
+}
+
+void ClearGeometryCache()
+{
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    for(auto it = geometryCache.begin(); it != geometryCache.end(); ++it)
+        delete it->second;
+    geometryCache.clear();
+}
+
+Mesh* CopyMesh(const Mesh* mesh)
+{
+    if(mesh == nullptr)
+        return nullptr;
+    else if(mesh->isTexturable())
+        return new TexturableMesh(*(const TexturableMesh*)mesh);
+    else
+        return new PlainMesh(*(const PlainMesh*)mesh);
+}
+
 Mesh* LoadGeometryFromFile(const std::string& path, GLfloat scale)
 {
+    std::string key;
+    {
+        std::lock_guard<std::mutex> lock(geometryCacheMutex);
+        if(geometryCacheEnabled)
+        {
+            key = path + "@" + std::to_string(scale);
+            auto it = geometryCache.find(key);
+            if(it != geometryCache.end())
+                return CopyMesh(it->second);
+        }
+    }
+
     std::string extension = path.substr(path.length()-3,3);
     Mesh* mesh = nullptr;
     
@@ -44,9 +88,329 @@ Mesh* LoadGeometryFromFile(const std::string& path, GLfloat scale)
     else
         cError("Unsupported geometry file type: %s!", extension.c_str());
     
+    if(mesh != nullptr && key != "")
+    {
+        std::lock_guard<std::mutex> lock(geometryCacheMutex);
+        if(geometryCache.find(key) == geometryCache.end()) //Another thread could have loaded the same file
+            geometryCache[key] = CopyMesh(mesh);
+    }
+    
     return mesh;
 }
 
+struct SharedGeometry
+{
+    ProcessedGeometry geom;
+    size_t users;
+};
+
+struct MeshCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t texturable;
+    uint32_t keyLength;
+    uint64_t nVertices;
+    uint64_t nFaces;
+    double mass;
+    double CG[3];
+    double volume;
+    double surface;
+    double Ipri[3];
+    double Irot[9];
+    double ellipsoidAxes[3];
+};
+
+static const uint32_t meshCacheVersion = 2;
+static std::string meshCacheDir = "";
+static std::map<std::string, SharedGeometry> sharedGeometry;
+static std::map<const Mesh*, std::string> sharedMeshKeys;
+static bool retainGeometry = false;
+
+std::string MakeGeometryCacheKey(const std::string& path, const std::string& params)
+{
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if(ec) size = 0;
+    long long mtime = (long long)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if(ec) mtime = 0;
+    return path + "@" + params + "@" + std::to_string((unsigned long long)size) + "@" + std::to_string(mtime);
+}
+
+std::string GetMeshCacheFilename(const std::string& key, const std::string& extension)
+{
+    std::string cacheDir;
+    {
+        std::lock_guard<std::mutex> lock(geometryCacheMutex);
+        cacheDir = meshCacheDir;
+    }
+    if(cacheDir == "")
+        return "";
+    
+    //FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for(size_t i=0; i<key.size(); ++i)
+    {
+        h ^= (uint8_t)key[i];
+        h *= 1099511628211ULL;
+    }
+    char name[32];
+    snprintf(name, 32, "%016llx.", (unsigned long long)h);
+    return (std::filesystem::path(cacheDir) / (std::string(name) + extension)).string();
+}
+
+static bool ReadMeshCache(const std::string& filename, const std::string& key, ProcessedGeometry& geom)
+{
+    std::error_code ec;
+    uint64_t fileSize = (uint64_t)std::filesystem::file_size(filename, ec);
+    if(ec)
+        return false;
+    
+    FILE* file = fopen(filename.c_str(), "rb");
+    if(file == NULL)
+        return false;
+    
+    MeshCacheHeader h;
+    bool ok = fileSize >= sizeof(MeshCacheHeader)
+              && fread(&h, sizeof(MeshCacheHeader), 1, file) == 1
+              && memcmp(h.magic, "SFMC", 4) == 0
+              && h.version == meshCacheVersion
+              && h.keyLength == key.size();
+    if(ok) //Counts have to match the file size, so a corrupted file is a cache miss and not a huge allocation
+    {
+        uint64_t headerSize = sizeof(MeshCacheHeader) + h.keyLength + (8 - h.keyLength % 8) % 8;
+        uint64_t dataSize = fileSize >= headerSize ? fileSize - headerSize : 0;
+        uint64_t vertexSize = h.texturable ? sizeof(TexturableVertex) : sizeof(Vertex);
+        ok = fileSize >= headerSize
+             && h.nVertices <= dataSize / vertexSize
+             && h.nFaces <= dataSize / sizeof(Face)
+             && h.nVertices * vertexSize + h.nFaces * sizeof(Face) == dataSize;
+    }
+    if(ok) //Protect against hash collisions
+    {
+        std::string storedKey(h.keyLength, '\0');
+        ok = fread(&storedKey[0], 1, h.keyLength, file) == h.keyLength && storedKey == key;
+        ok = ok && fseek(file, (8 - h.keyLength % 8) % 8, SEEK_CUR) == 0; //Padding
+    }
+    
+    Mesh* mesh = nullptr;
+    if(ok)
+    {
+        if(h.texturable)
+        {
+            TexturableMesh* tmesh = new TexturableMesh;
+            tmesh->vertices.resize(h.nVertices);
+            ok = fread(tmesh->vertices.data(), sizeof(TexturableVertex), h.nVertices, file) == h.nVertices;
+            mesh = tmesh;
+        }
+        else
+        {
+            PlainMesh* pmesh = new PlainMesh;
+            pmesh->vertices.resize(h.nVertices);
+            ok = fread(pmesh->vertices.data(), sizeof(Vertex), h.nVertices, file) == h.nVertices;
+            mesh = pmesh;
+        }
+        mesh->faces.resize(h.nFaces);
+        ok = ok && fread(mesh->faces.data(), sizeof(Face), h.nFaces, file) == h.nFaces;
+    }
+    fclose(file);
+    
+    if(!ok)
+    {
+        if(mesh != nullptr)
+            delete mesh;
+        return false;
+    }
+    
+    geom.mesh = mesh;
+    geom.properties.mass = Scalar(h.mass);
+    geom.properties.CG = Vector3(h.CG[0], h.CG[1], h.CG[2]);
+    geom.properties.volume = Scalar(h.volume);
+    geom.properties.surface = Scalar(h.surface);
+    geom.properties.Ipri = Vector3(h.Ipri[0], h.Ipri[1], h.Ipri[2]);
+    geom.properties.Irot = Matrix3(h.Irot[0], h.Irot[1], h.Irot[2], h.Irot[3], h.Irot[4], h.Irot[5], h.Irot[6], h.Irot[7], h.Irot[8]);
+    geom.ellipsoidAxes = Vector3(h.ellipsoidAxes[0], h.ellipsoidAxes[1], h.ellipsoidAxes[2]);
+    return true;
+}
+
+static void WriteMeshCache(const std::string& filename, const std::string& key, const ProcessedGeometry& geom)
+{
+    MeshCacheHeader h;
+    memset(&h, 0, sizeof(MeshCacheHeader));
+    memcpy(h.magic, "SFMC", 4);
+    h.version = meshCacheVersion;
+    h.texturable = geom.mesh->isTexturable() ? 1 : 0;
+    h.keyLength = (uint32_t)key.size();
+    h.nVertices = geom.mesh->getNumOfVertices();
+    h.nFaces = geom.mesh->faces.size();
+    h.mass = geom.properties.mass;
+    h.volume = geom.properties.volume;
+    h.surface = geom.properties.surface;
+    for(int i=0; i<3; ++i)
+    {
+        h.CG[i] = geom.properties.CG.m_floats[i];
+        h.Ipri[i] = geom.properties.Ipri.m_floats[i];
+        h.ellipsoidAxes[i] = geom.ellipsoidAxes.m_floats[i];
+        for(int k=0; k<3; ++k)
+            h.Irot[i*3+k] = geom.properties.Irot.getRow(i).m_floats[k];
+    }
+    
+    //Write to a temporary file first, so that other processes never see a partial file
+    std::string tmpFilename = filename + "." + std::to_string(GetTimeInNanoseconds()) + ".tmp";
+    FILE* file = fopen(tmpFilename.c_str(), "wb");
+    if(file == NULL)
+    {
+        cWarning("Failed to write mesh cache file: %s", filename.c_str());
+        return;
+    }
+    
+    const char padding[8] = {0};
+    bool ok = fwrite(&h, sizeof(MeshCacheHeader), 1, file) == 1
+              && fwrite(key.data(), 1, key.size(), file) == key.size()
+              && fwrite(padding, 1, (8 - key.size() % 8) % 8, file) == (8 - key.size() % 8) % 8
+              && fwrite(geom.mesh->getVertexDataPointer(), geom.mesh->getVertexSize(), h.nVertices, file) == h.nVertices
+              && fwrite(geom.mesh->getFaceDataPointer(), sizeof(Face), h.nFaces, file) == h.nFaces;
+    fclose(file);
+    
+    std::error_code ec;
+    if(ok)
+        std::filesystem::rename(tmpFilename, filename, ec);
+    if(!ok || ec)
+    {
+        std::filesystem::remove(tmpFilename, ec);
+        cWarning("Failed to write mesh cache file: %s", filename.c_str());
+    }
+}
+
+static ProcessedGeometry ProcessGeometry(const std::string& path, GLfloat scale, GLfloat refineThreshold, Scalar thickness, Scalar density)
+{
+    ProcessedGeometry geom;
+    geom.mesh = OpenGLContent::LoadMesh(path, scale, false);
+    if(refineThreshold > 0.f)
+        OpenGLContent::Refine(geom.mesh, refineThreshold);
+    geom.properties = ComputePhysicalProperties(geom.mesh, thickness, density);
+    
+    //Extent of the mesh in the CG frame, aligned with the principal axes of inertia (ellipsoidal approximation)
+    Transform T_CG2C = Transform(geom.properties.Irot, V0()).inverse() * Transform(I3(), -geom.properties.CG);
+    Vector3 vmin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    Vector3 vmax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    for(size_t i=0; i<geom.mesh->getNumOfVertices(); ++i)
+    {
+        glm::vec3 pos = geom.mesh->getVertexPos(i);
+        Vector3 v = T_CG2C * Vector3(pos.x, pos.y, pos.z);
+        vmin.setMin(v);
+        vmax.setMax(v);
+    }
+    geom.ellipsoidAxes = geom.mesh->getNumOfVertices() > 0 ? (vmax - vmin)/Scalar(2) : V0();
+    return geom;
+}
+
+void EnableMeshCache(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    meshCacheDir = directory;
+    if(meshCacheDir != "")
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(meshCacheDir, ec);
+        if(ec)
+        {
+            cWarning("Failed to create mesh cache directory: %s", meshCacheDir.c_str());
+            meshCacheDir = "";
+        }
+    }
+}
+
+const ProcessedGeometry* LoadProcessedGeometry(const std::string& path, GLfloat scale, GLfloat refineThreshold, Scalar thickness, Scalar density)
+{
+    char params[128];
+    snprintf(params, 128, "%.9g@%.9g@%.17g@%.17g", (double)scale, (double)refineThreshold, (double)thickness, (double)density);
+    std::string key = MakeGeometryCacheKey(path, std::string(params));
+    {
+        std::lock_guard<std::mutex> lock(geometryCacheMutex);
+        auto it = sharedGeometry.find(key);
+        if(it != sharedGeometry.end())
+        {
+            ++it->second.users;
+            return &it->second.geom;
+        }
+    }
+    
+    //Not in memory -> try the disk cache or process the file
+    ProcessedGeometry geom;
+    std::string cacheFilename = GetMeshCacheFilename(key, "sfmesh");
+    
+    if(cacheFilename != "" && ReadMeshCache(cacheFilename, key, geom))
+        cInfo("Loaded processed geometry from cache: %s", path.c_str());
+    else
+    {
+        geom = ProcessGeometry(path, scale, refineThreshold, thickness, density);
+        if(cacheFilename != "")
+            WriteMeshCache(cacheFilename, key, geom);
+    }
+    
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    auto it = sharedGeometry.find(key);
+    if(it != sharedGeometry.end()) //Another thread could have loaded the same file
+    {
+        delete geom.mesh;
+        ++it->second.users;
+        return &it->second.geom;
+    }
+    SharedGeometry& shared = sharedGeometry[key];
+    shared.geom = geom;
+    shared.users = 1;
+    sharedMeshKeys[geom.mesh] = key;
+    return &shared.geom;
+}
+
+void ReleaseMesh(Mesh* mesh)
+{
+    if(mesh == nullptr)
+        return;
+    
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    auto kit = sharedMeshKeys.find(mesh);
+    if(kit == sharedMeshKeys.end())
+    {
+        delete mesh;
+        return;
+    }
+    auto it = sharedGeometry.find(kit->second);
+    if(--it->second.users == 0 && !retainGeometry)
+    {
+        delete mesh;
+        sharedGeometry.erase(it);
+        sharedMeshKeys.erase(kit);
+    }
+}
+
+void RetainProcessedGeometry(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(geometryCacheMutex);
+        retainGeometry = enabled;
+    }
+    if(!enabled)
+        ReleaseUnusedGeometry();
+}
+
+void ReleaseUnusedGeometry()
+{
+    std::lock_guard<std::mutex> lock(geometryCacheMutex);
+    for(auto it = sharedGeometry.begin(); it != sharedGeometry.end();)
+    {
+        if(it->second.users == 0)
+        {
+            sharedMeshKeys.erase(it->second.geom.mesh);
+            delete it->second.geom.mesh;
+            it = sharedGeometry.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
 Mesh* LoadOBJ(const std::string& path, GLfloat scale)
 {
     //Read OBJ data
@@ -24,21 +24,22 @@
 //
 
 #include "utils/PerformanceMonitor.h"
-#include <numeric>
 
 namespace sf
 {
 
 PerformanceMonitor::PerformanceMonitor(size_t averageMaxCount)
 {
-    maxCount = averageMaxCount;
+    maxCount = averageMaxCount > 0 ? averageMaxCount : 1;
     
     simTime = 0;
     simFinished = true;
-    phyTime = std::deque<double>(0);
+    Reset(phyTime);
     phyTimeAvg = 0;
-    hydroTime = std::deque<double>(0);
+    Reset(hydroTime);
     hydroTimeAvg = 0;
+    Reset(sensTime);
+    sensTimeAvg = 0;
     updateMtx = SDL_CreateMutex();
 }
 
@@ -53,10 +54,13 @@ void PerformanceMonitor::SimulationStarted()
     simStart = std::chrono::high_resolution_clock::now();
     simTime = 0;
     simFinished = false;
-    phyTime.clear();
+    Reset(phyTime);
     phyTimeAvg = 0;
-    hydroTime.clear();
+    Reset(hydroTime);
     hydroTimeAvg = 0;
+    Reset(sensTime);
+    sensTimeAvg = 0;
+    sensorTimeAvg.clear();
     SDL_UnlockMutex(updateMtx);
 }
 
@@ -89,6 +93,31 @@ void PerformanceMonitor::HydrodynamicsFinished()
     Update(hydroStart, hydroTime, hydroTimeAvg);
 }
 
+void PerformanceMonitor::SensorsStarted()
+{
+    sensStart = std::chrono::high_resolution_clock::now();
+}
+
+void PerformanceMonitor::SensorsFinished()
+{
+    Update(sensStart, sensTime, sensTimeAvg);
+}
+
+void PerformanceMonitor::SensorsUpdated(const std::vector<std::string>& names, const std::vector<double>& times)
+{
+    SDL_LockMutex(updateMtx);
+    double filter = 1.0/(double)maxCount;
+    for(size_t i=0; i<names.size() && i<times.size(); ++i)
+    {
+        auto it = sensorTimeAvg.find(names[i]);
+        if(it == sensorTimeAvg.end())
+            sensorTimeAvg[names[i]] = times[i];
+        else
+            it->second = filter * times[i] + (1.0-filter) * it->second;
+    }
+    SDL_UnlockMutex(updateMtx);
+}
+
 double PerformanceMonitor::getSimulationTime()
 {
     SDL_LockMutex(updateMtx);
@@ -105,7 +134,7 @@ double PerformanceMonitor::getSimulationTime()
 double PerformanceMonitor::getPhysicsTime()
 {
     SDL_LockMutex(updateMtx);
-    double t = phyTime.back();
+    double t = phyTime.count > 0 ? phyTime.data[(phyTime.head + maxCount - 1) % maxCount] : 0.0;
     SDL_UnlockMutex(updateMtx);
     return t;
 }
@@ -121,7 +150,7 @@ double PerformanceMonitor::getPhysicsTimeAverage()
 double PerformanceMonitor::getHydrodynamicsTime()
 {
     SDL_LockMutex(updateMtx);
-    double t = hydroTime.back();
+    double t = hydroTime.count > 0 ? hydroTime.data[(hydroTime.head + maxCount - 1) % maxCount] : 0.0;
     SDL_UnlockMutex(updateMtx);
     return t;
 }
@@ -134,19 +163,55 @@ double PerformanceMonitor::getHydrodynamicsTimeAverage()
     return t;
 }
 
-void PerformanceMonitor::Update(const std::chrono::high_resolution_clock::time_point& start, std::deque<double>& times, double& average)
+double PerformanceMonitor::getSensorsTime()
+{
+    SDL_LockMutex(updateMtx);
+    double t = sensTime.count > 0 ? sensTime.data[(sensTime.head + maxCount - 1) % maxCount] : 0.0;
+    SDL_UnlockMutex(updateMtx);
+    return t;
+}
+
+double PerformanceMonitor::getSensorsTimeAverage()
+{
+    SDL_LockMutex(updateMtx);
+    double t = sensTimeAvg;
+    SDL_UnlockMutex(updateMtx);
+    return t;
+}
+
+std::vector<std::pair<std::string, double>> PerformanceMonitor::getSensorTimeAverages()
+{
+    SDL_LockMutex(updateMtx);
+    std::vector<std::pair<std::string, double>> avgs(sensorTimeAvg.begin(), sensorTimeAvg.end());
+    SDL_UnlockMutex(updateMtx);
+    return avgs;
+}
+
+void PerformanceMonitor::Update(const std::chrono::high_resolution_clock::time_point& start, TimeHistory& times, double& average)
 {
     // Compute elapsed time
     auto end = std::chrono::high_resolution_clock::now();
-    SDL_LockMutex(updateMtx);
     double elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    // Update averaging queue
-    times.push_back(elapsed);
-    if(times.size() > maxCount)
-        times.pop_front();
+    SDL_LockMutex(updateMtx);
+    // Update ring buffer and running sum
+    if(times.count == maxCount)
+        times.sum -= times.data[times.head];
+    else
+        ++times.count;
+    times.data[times.head] = elapsed;
+    times.sum += elapsed;
+    times.head = (times.head + 1) % maxCount;
     // Update average
-    average = std::accumulate(times.begin(), times.end(), 0.0) / (double)times.size();
+    average = times.sum / (double)times.count;
     SDL_UnlockMutex(updateMtx);
 }
 
-}
\ No newline at end of file
+void PerformanceMonitor::Reset(TimeHistory& times)
+{
+    times.data.assign(maxCount, 0.0);
+    times.head = 0;
+    times.count = 0;
+    times.sum = 0.0;
+}
+
+}
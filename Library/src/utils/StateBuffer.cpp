@@ -0,0 +1,133 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  StateBuffer.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "utils/StateBuffer.h"
+
+#include <cstring>
+
+namespace sf
+{
+
+StateBuffer::StateBuffer()
+{
+}
+
+void StateBuffer::Clear()
+{
+    data.clear();
+}
+
+void StateBuffer::Write(const Transform& value)
+{
+    //Basis stored directly, conversion to a quaternion would not be exact
+    Write(value.getBasis().getRow(0));
+    Write(value.getBasis().getRow(1));
+    Write(value.getBasis().getRow(2));
+    Write(value.getOrigin());
+}
+
+void StateBuffer::Write(const std::string& value)
+{
+    Write((uint64_t)value.size());
+    WriteBytes(value.data(), value.size());
+}
+
+void StateBuffer::WriteBytes(const void* src, size_t size)
+{
+    size_t offset = data.size();
+    data.resize(offset + size);
+    if(size > 0)
+        memcpy(&data[offset], src, size);
+}
+
+const char* StateBuffer::getData() const
+{
+    return data.data();
+}
+
+size_t StateBuffer::getSize() const
+{
+    return data.size();
+}
+
+StateReader::StateReader(const StateBuffer& buffer) : buffer(buffer), cursor(0), valid(true)
+{
+}
+
+void StateReader::Read(Transform& value)
+{
+    Vector3 r0, r1, r2, o;
+    Read(r0);
+    Read(r1);
+    Read(r2);
+    Read(o);
+    value.getBasis().setValue(r0.x(), r0.y(), r0.z(), r1.x(), r1.y(), r1.z(), r2.x(), r2.y(), r2.z());
+    value.setOrigin(o);
+}
+
+void StateReader::Read(std::string& value)
+{
+    uint64_t n = 0;
+    Read(n);
+    if(n > Remaining())
+    {
+        valid = false;
+        return;
+    }
+    value.assign(buffer.getData() + cursor, (size_t)n);
+    cursor += (size_t)n;
+}
+
+void StateReader::ReadBytes(void* dst, size_t size)
+{
+    if(size > Remaining())
+    {
+        valid = false;
+        memset(dst, 0, size);
+        cursor = buffer.getSize();
+        return;
+    }
+    if(size > 0)
+        memcpy(dst, buffer.getData() + cursor, size);
+    cursor += size;
+}
+
+bool StateReader::isValid() const
+{
+    return valid;
+}
+
+bool StateReader::isAtEnd() const
+{
+    return cursor == buffer.getSize();
+}
+
+size_t StateReader::Remaining() const
+{
+    return buffer.getSize() - cursor;
+}
+
+}
@@ -0,0 +1,416 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  TaskScheduler.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "utils/TaskScheduler.h"
+
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+#include "core/SimulationApp.h"
+
+namespace sf
+{
+
+#define SCHEDULER_SPIN_COUNT 64 //Number of attempts to find a task before a worker goes to sleep
+
+struct ScheduledTask
+{
+    std::function<void()> func;
+    std::atomic<size_t>* pending; //Counter of unfinished tasks of the job
+    SimulationManager* sim; //Simulation manager bound to the submitting thread
+};
+
+struct TaskQueue
+{
+    std::mutex mutex;
+    std::deque<ScheduledTask> tasks;
+};
+
+//Queue 0 -> tasks submitted by other threads, queue i>0 -> tasks submitted by worker i-1
+static std::vector<std::unique_ptr<TaskQueue>> queues;
+static std::vector<std::thread> workers;
+static std::mutex poolMutex;
+static std::mutex sleepMutex;
+static std::condition_variable wakeUp;
+static std::mutex waitMutex;
+static std::condition_variable jobFinished;
+static bool quit = false;
+static std::atomic<size_t> queuedTasks(0);
+static std::atomic<size_t> activeJobs(0); //Parallel loops and graphs in progress
+static std::atomic<bool> started(false);
+static unsigned int nThreads = 1;
+static bool pinned = false;
+static std::atomic<bool> locked(false);
+static thread_local int workerIndex = -1;
+
+//Takes the newest task from the own queue or the oldest task from the other queues (only tasks of the specified job, if any)
+static bool PopTask(ScheduledTask& task, const std::atomic<size_t>* job = nullptr)
+{
+    if(queuedTasks.load(std::memory_order_acquire) == 0)
+        return false;
+    
+    size_t own = workerIndex >= 0 ? (size_t)workerIndex + 1 : 0;
+    size_t n = queues.size();
+    for(size_t i=0; i<=n; ++i)
+    {
+        if(i == 0 && workerIndex < 0)
+            continue;
+        TaskQueue& q = *queues[(own + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(q.tasks.empty())
+            continue;
+        
+        if(job == nullptr)
+        {
+            if(i == 0)
+            {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            --queuedTasks;
+            return true;
+        }
+        
+        for(size_t k=0; k<q.tasks.size(); ++k)
+        {
+            auto it = i == 0 ? q.tasks.end() - 1 - k : q.tasks.begin() + k;
+            if(it->pending == job)
+            {
+                task = std::move(*it);
+                q.tasks.erase(it);
+                --queuedTasks;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void RunTask(ScheduledTask& task)
+{
+    SimulationManager* sim = SimulationApp::getThreadSimulationManager();
+    SimulationApp::setThreadSimulationManager(task.sim);
+    task.func();
+    SimulationApp::setThreadSimulationManager(sim);
+    task.func = nullptr;
+    if(task.pending->fetch_sub(1, std::memory_order_acq_rel) == 1) //Waiting thread may return after this
+    {
+        {
+            std::lock_guard<std::mutex> lock(waitMutex); //Prevents a lost wake-up
+        }
+        jobFinished.notify_all();
+    }
+}
+
+static void WorkerLoop(int index)
+{
+    workerIndex = index;
+    ScheduledTask task;
+    
+    while(true)
+    {
+        bool found = false;
+        for(unsigned int i=0; i<SCHEDULER_SPIN_COUNT && !found; ++i)
+        {
+            if((found = PopTask(task)))
+                RunTask(task);
+            else
+                std::this_thread::yield();
+        }
+        
+        if(!found)
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, []{ return quit || queuedTasks.load() > 0; });
+            if(quit)
+                break;
+        }
+    }
+}
+
+static void PinThread(std::thread& thread, unsigned int core)
+{
+#ifdef __linux__
+    unsigned int numCores = std::max(std::thread::hardware_concurrency(), 1u);
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core % numCores, &cpus);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpus);
+#endif
+}
+
+static void StartWorkers(unsigned int numThreads, bool pinThreads)
+{
+    nThreads = numThreads > 0 ? numThreads : std::max(std::thread::hardware_concurrency()/2, 1u);
+    pinned = pinThreads;
+    quit = false;
+    
+    queues.clear();
+    for(unsigned int i=0; i<nThreads; ++i)
+        queues.emplace_back(new TaskQueue());
+    
+    for(unsigned int i=0; i+1<nThreads; ++i)
+    {
+        workers.emplace_back(WorkerLoop, (int)i);
+        if(pinned)
+            PinThread(workers.back(), i+1); //Core 0 left for the calling thread
+    }
+    started = true;
+}
+
+static void StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wakeUp.notify_all();
+    
+    for(size_t i=0; i<workers.size(); ++i)
+        workers[i].join();
+    workers.clear();
+    queues.clear();
+    started = false;
+}
+
+static void EnsureStarted()
+{
+    if(!started.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if(!started)
+            StartWorkers(0, false);
+    }
+}
+
+//Worker threads have to be joined before the static objects are destroyed
+static struct SchedulerGuard
+{
+    ~SchedulerGuard() { TaskScheduler::Shutdown(); }
+} schedulerGuard;
+
+void TaskScheduler::Init(unsigned int numThreads, bool pinThreads)
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if(activeJobs > 0)
+    {
+        if(SimulationApp::getApp() != nullptr)
+            cWarning("Task scheduler is busy! Number of threads not changed.");
+        return;
+    }
+    
+    if(started)
+        StopWorkers();
+    StartWorkers(numThreads, pinThreads);
+}
+
+void TaskScheduler::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if(started)
+        StopWorkers();
+}
+
+unsigned int TaskScheduler::getNumOfThreads()
+{
+    EnsureStarted();
+    return nThreads;
+}
+
+bool TaskScheduler::isPinningThreads()
+{
+    return pinned;
+}
+
+void TaskScheduler::setLocked(bool enabled)
+{
+    locked.store(enabled);
+}
+
+bool TaskScheduler::isLocked()
+{
+    return locked.load();
+}
+
+void TaskScheduler::Submit(const std::function<void()>& task, std::atomic<size_t>* pending)
+{
+    ++queuedTasks;
+    TaskQueue& q = *queues[workerIndex >= 0 ? (size_t)workerIndex + 1 : 0];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(ScheduledTask{task, pending, SimulationApp::getThreadSimulationManager()});
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex); //Prevents a lost wake-up
+    }
+    wakeUp.notify_one();
+}
+
+void TaskScheduler::Wait(std::atomic<size_t>* pending)
+{
+    //Only tasks of the same job are run, because the caller can hold locks (e.g. of its simulation world)
+    ScheduledTask task;
+    unsigned int attempts = 0;
+    while(pending->load(std::memory_order_acquire) > 0)
+    {
+        if(PopTask(task, pending))
+        {
+            RunTask(task);
+            attempts = 0;
+        }
+        else if(++attempts < SCHEDULER_SPIN_COUNT)
+            std::this_thread::yield();
+        else //Remaining tasks are running -> sleep, checking for new tasks of the job from time to time
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            jobFinished.wait_for(lock, std::chrono::microseconds(100), [pending]{ return pending->load() == 0; });
+            attempts = 0;
+        }
+    }
+}
+
+void TaskScheduler::ParallelFor(size_t begin, size_t end, const std::function<void(size_t)>& func, size_t grain)
+{
+    if(end <= begin)
+        return;
+    
+    grain = std::max(grain, (size_t)1);
+    size_t numChunks = (end - begin + grain - 1)/grain;
+    size_t numTasks = std::min((size_t)getNumOfThreads(), numChunks);
+    
+    if(numTasks <= 1)
+    {
+        for(size_t i=begin; i<end; ++i)
+            func(i);
+        return;
+    }
+    
+    //Tasks take chunks of indices until the range is exhausted, the calling thread takes part
+    ++activeJobs;
+    std::atomic<size_t> next(begin);
+    std::function<void()> chunks = [&next, end, grain, &func]()
+    {
+        size_t i;
+        while((i = next.fetch_add(grain)) < end)
+        {
+            size_t chunkEnd = std::min(i + grain, end);
+            for(; i<chunkEnd; ++i)
+                func(i);
+        }
+    };
+    
+    std::atomic<size_t> pending(numTasks - 1);
+    for(size_t i=1; i<numTasks; ++i)
+        Submit(chunks, &pending);
+    chunks();
+    Wait(&pending);
+    --activeJobs;
+}
+
+TaskGraph::TaskGraph() : pending(0)
+{
+}
+
+size_t TaskGraph::AddTask(const std::function<void()>& task, const std::vector<size_t>& dependencies)
+{
+    size_t id = nodes.size();
+    Node node;
+    node.task = task;
+    node.numDependencies = 0;
+    nodes.push_back(node);
+    
+    for(size_t i=0; i<dependencies.size(); ++i)
+    {
+        if(dependencies[i] >= id) //Only tasks added earlier -> graph is acyclic
+            continue;
+        nodes[dependencies[i]].successors.push_back(id);
+        ++nodes[id].numDependencies;
+    }
+    return id;
+}
+
+void TaskGraph::Run()
+{
+    if(nodes.empty())
+        return;
+    
+    //Tasks are stored in a valid order of execution
+    if(TaskScheduler::getNumOfThreads() == 1)
+    {
+        for(size_t i=0; i<nodes.size(); ++i)
+            nodes[i].task();
+        return;
+    }
+    
+    ++activeJobs;
+    remaining = std::vector<std::atomic<size_t>>(nodes.size());
+    for(size_t i=0; i<nodes.size(); ++i)
+        remaining[i].store(nodes[i].numDependencies);
+    pending.store(nodes.size());
+    
+    for(size_t i=0; i<nodes.size(); ++i)
+        if(nodes[i].numDependencies == 0)
+            TaskScheduler::Submit([this, i]() { RunNode(i); }, &pending);
+    TaskScheduler::Wait(&pending);
+    --activeJobs;
+}
+
+void TaskGraph::RunNode(size_t id)
+{
+    nodes[id].task();
+    
+    for(size_t i=0; i<nodes[id].successors.size(); ++i)
+    {
+        size_t s = nodes[id].successors[i];
+        if(remaining[s].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            TaskScheduler::Submit([this, s]() { RunNode(s); }, &pending);
+    }
+}
+
+void TaskGraph::Clear()
+{
+    nodes.clear();
+}
+
+size_t TaskGraph::getNumOfTasks() const
+{
+    return nodes.size();
+}
+
+}
@@ -0,0 +1,422 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  TickProfiler.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "utils/TickProfiler.h"
+
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdio>
+#include "LinearMath/btQuickprof.h"
+
+namespace sf
+{
+
+#define PROFILER_BUFFER_SIZE 65536 //Number of events stored per thread (power of 2)
+#define PROFILER_MAX_DEPTH 64 //Maximum depth of nested scopes
+
+struct ProfileEvent
+{
+    const char* name;
+    const char* parent;
+    int64_t start; //[ns]
+    int64_t duration; //[ns] (negative for counters)
+    double value; //Value of a counter
+};
+
+//A slot of the ring buffer, guarded by a sequence lock (odd while written, 2*(index+1) when holding event index)
+struct ProfileEventSlot
+{
+    std::atomic<uint64_t> seq;
+    std::atomic<const char*> name;
+    std::atomic<const char*> parent;
+    std::atomic<int64_t> start;
+    std::atomic<int64_t> duration;
+    std::atomic<double> value;
+};
+
+struct ProfilerThreadBuffer
+{
+    unsigned int id;
+    bool used;
+    std::unique_ptr<ProfileEventSlot[]> events;
+    std::atomic<uint64_t> head;
+};
+
+struct ProfilerScopeState
+{
+    const char* name;
+    const char* parent;
+    int64_t start;
+};
+
+static ProfilerThreadBuffer* AcquireThreadBuffer();
+static void ReleaseThreadBuffer(ProfilerThreadBuffer* buffer);
+
+struct ProfilerThreadState
+{
+    ProfilerThreadBuffer* buffer;
+    ProfilerScopeState stack[PROFILER_MAX_DEPTH];
+    unsigned int depth;
+    std::unordered_map<std::string, const char*> names;
+    
+    ProfilerThreadState() : buffer(nullptr), depth(0) {}
+    ~ProfilerThreadState() { if(buffer != nullptr) ReleaseThreadBuffer(buffer); }
+};
+
+static std::mutex profilerMutex;
+static std::vector<std::unique_ptr<ProfilerThreadBuffer>> threadBuffers;
+static std::unordered_set<std::string> internedNames;
+static std::atomic<int64_t> clearTime(0);
+static bool engineZonesHooked = false;
+static thread_local ProfilerThreadState threadState;
+
+std::atomic<bool> TickProfiler::enabled(false);
+
+static ProfilerThreadBuffer* AcquireThreadBuffer()
+{
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    //Reuse buffers of finished threads (their events stay until overwritten)
+    for(size_t i=0; i<threadBuffers.size(); ++i)
+        if(!threadBuffers[i]->used)
+        {
+            threadBuffers[i]->used = true;
+            return threadBuffers[i].get();
+        }
+    
+    threadBuffers.push_back(std::make_unique<ProfilerThreadBuffer>());
+    ProfilerThreadBuffer* buffer = threadBuffers.back().get();
+    buffer->id = (unsigned int)threadBuffers.size() - 1;
+    buffer->used = true;
+    buffer->events.reset(new ProfileEventSlot[PROFILER_BUFFER_SIZE]()); //Zeroed
+    buffer->head.store(0);
+    return buffer;
+}
+
+static void ReleaseThreadBuffer(ProfilerThreadBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    buffer->used = false;
+}
+
+//Copies the events recorded after the specified time
+static std::vector<std::pair<unsigned int, ProfileEvent>> CollectEvents(int64_t since)
+{
+    std::vector<std::pair<unsigned int, ProfileEvent>> events;
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    for(size_t i=0; i<threadBuffers.size(); ++i)
+    {
+        ProfilerThreadBuffer* buffer = threadBuffers[i].get();
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t n = std::min<uint64_t>(head, PROFILER_BUFFER_SIZE);
+        for(uint64_t h=head-n; h<head; ++h)
+        {
+            //Slots overwritten by the owning thread while being copied are skipped
+            const ProfileEventSlot& slot = buffer->events[h & (PROFILER_BUFFER_SIZE-1)];
+            uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if(seq != 2*(h+1))
+                continue;
+            ProfileEvent e;
+            e.name = slot.name.load(std::memory_order_relaxed);
+            e.parent = slot.parent.load(std::memory_order_relaxed);
+            e.start = slot.start.load(std::memory_order_relaxed);
+            e.duration = slot.duration.load(std::memory_order_relaxed);
+            e.value = slot.value.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.seq.load(std::memory_order_relaxed) != seq)
+                continue;
+            if(e.name != nullptr && e.start >= since)
+                events.push_back(std::make_pair(buffer->id, e));
+        }
+    }
+    return events;
+}
+
+static void RecordEvent(ProfilerThreadBuffer* buffer, const char* name, const char* parent, int64_t start, int64_t duration, double value)
+{
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    ProfileEventSlot& slot = buffer->events[head & (PROFILER_BUFFER_SIZE-1)];
+    slot.seq.store(2*head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.parent.store(parent, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.seq.store(2*(head + 1), std::memory_order_release);
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+static void EngineZoneBegin(const char* name)
+{
+    TickProfiler::Begin(name);
+}
+
+static void EngineZoneEnd()
+{
+    TickProfiler::End();
+}
+
+static std::string EscapeJSON(const char* str)
+{
+    std::string out;
+    for(const char* c = str; *c != '\0'; ++c)
+    {
+        if(*c == '"' || *c == '\\')
+        {
+            out.push_back('\\');
+            out.push_back(*c);
+        }
+        else if((unsigned char)*c < 0x20)
+            out.push_back(' ');
+        else
+            out.push_back(*c);
+    }
+    return out;
+}
+
+typedef std::pair<std::string, std::pair<int64_t, unsigned int>> ProfilerNode; //Name, total time [ns], calls
+typedef std::multimap<std::string, ProfilerNode> ProfilerTree; //Parent name -> node
+
+static void EmitScopes(const ProfilerTree& tree, const std::string& parent, unsigned int depth, double span, std::vector<TickProfilerEntry>& summary)
+{
+    if(depth > 16) //Guard against scopes nested in scopes with the same name
+        return;
+    
+    auto range = tree.equal_range(parent);
+    std::vector<ProfilerNode> nodes;
+    for(auto it = range.first; it != range.second; ++it)
+        nodes.push_back(it->second);
+    std::sort(nodes.begin(), nodes.end(), [](const ProfilerNode& a, const ProfilerNode& b) { return a.second.first > b.second.first; });
+    
+    for(size_t i=0; i<nodes.size(); ++i)
+    {
+        TickProfilerEntry entry;
+        entry.name = nodes[i].first;
+        entry.depth = depth;
+        entry.calls = nodes[i].second.second;
+        entry.averageTime = (double)nodes[i].second.first/(double)entry.calls/1000.0;
+        entry.load = (double)nodes[i].second.first/span;
+        summary.push_back(entry);
+        EmitScopes(tree, entry.name, depth + 1, span, summary);
+    }
+}
+
+int64_t TickProfiler::Now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void TickProfiler::Enable(bool e)
+{
+    if(e)
+    {
+        //Record the zones of the physics engine (hooks are never removed, to keep zones balanced)
+        std::lock_guard<std::mutex> lock(profilerMutex);
+        if(!engineZonesHooked)
+        {
+            btSetCustomEnterProfileZoneFunc(EngineZoneBegin);
+            btSetCustomLeaveProfileZoneFunc(EngineZoneEnd);
+            engineZonesHooked = true;
+        }
+    }
+    enabled.store(e, std::memory_order_relaxed);
+}
+
+bool TickProfiler::isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void TickProfiler::Begin(const char* name, const char* parent)
+{
+    ProfilerThreadState& t = threadState;
+    if(t.depth < PROFILER_MAX_DEPTH)
+    {
+        ProfilerScopeState& s = t.stack[t.depth];
+        s.name = name;
+        s.parent = t.depth > 0 ? t.stack[t.depth-1].name : parent;
+        s.start = (name != nullptr && enabled.load(std::memory_order_relaxed)) ? Now() : -1;
+    }
+    ++t.depth;
+}
+
+void TickProfiler::End()
+{
+    ProfilerThreadState& t = threadState;
+    if(t.depth == 0) //Zone opened before the engine hooks were installed
+        return;
+    --t.depth;
+    if(t.depth >= PROFILER_MAX_DEPTH)
+        return;
+    
+    const ProfilerScopeState& s = t.stack[t.depth];
+    if(s.start < 0 || !enabled.load(std::memory_order_relaxed))
+        return;
+    
+    if(t.buffer == nullptr)
+        t.buffer = AcquireThreadBuffer();
+    RecordEvent(t.buffer, s.name, s.parent, s.start, Now() - s.start, 0.0);
+}
+
+void TickProfiler::Counter(const char* name, double value)
+{
+    if(name == nullptr || !enabled.load(std::memory_order_relaxed))
+        return;
+    
+    ProfilerThreadState& t = threadState;
+    if(t.buffer == nullptr)
+        t.buffer = AcquireThreadBuffer();
+    RecordEvent(t.buffer, name, nullptr, Now(), -1, value);
+}
+
+const char* TickProfiler::Intern(const std::string& name)
+{
+    ProfilerThreadState& t = threadState;
+    auto it = t.names.find(name);
+    if(it != t.names.end())
+        return it->second;
+    
+    const char* str;
+    {
+        std::lock_guard<std::mutex> lock(profilerMutex);
+        str = internedNames.insert(name).first->c_str();
+    }
+    t.names[name] = str;
+    return str;
+}
+
+void TickProfiler::Clear()
+{
+    clearTime.store(Now());
+}
+
+std::vector<TickProfilerEntry> TickProfiler::Summarize(double window)
+{
+    int64_t now = Now();
+    int64_t since = std::max(now - (int64_t)(window * 1e9), clearTime.load());
+    std::vector<TickProfilerEntry> summary;
+    if(now <= since)
+        return summary;
+    std::vector<std::pair<unsigned int, ProfileEvent>> events = CollectEvents(since);
+    
+    //Aggregate by name pointers first, then by contents
+    std::map<std::pair<const char*, const char*>, std::pair<int64_t, unsigned int>> byPtr;
+    for(size_t i=0; i<events.size(); ++i)
+    {
+        if(events[i].second.duration < 0)
+            continue;
+        std::pair<int64_t, unsigned int>& agg = byPtr[std::make_pair(events[i].second.parent, events[i].second.name)];
+        agg.first += events[i].second.duration;
+        ++agg.second;
+    }
+    
+    std::map<std::pair<std::string, std::string>, std::pair<int64_t, unsigned int>> byName;
+    for(auto it = byPtr.begin(); it != byPtr.end(); ++it)
+    {
+        std::pair<int64_t, unsigned int>& agg = byName[std::make_pair(std::string(it->first.first != nullptr ? it->first.first : ""), 
+                                                                      std::string(it->first.second))];
+        agg.first += it->second.first;
+        agg.second += it->second.second;
+    }
+    
+    //Build the tree (scopes with a parent that was not recorded, e.g. still open, become roots)
+    std::unordered_set<std::string> recorded;
+    for(auto it = byName.begin(); it != byName.end(); ++it)
+        recorded.insert(it->first.second);
+    
+    ProfilerTree tree;
+    for(auto it = byName.begin(); it != byName.end(); ++it)
+    {
+        std::string parent = recorded.count(it->first.first) > 0 ? it->first.first : "";
+        tree.insert(std::make_pair(parent, ProfilerNode(it->first.second, it->second)));
+    }
+    
+    EmitScopes(tree, "", 0, (double)(now - since), summary);
+    return summary;
+}
+
+std::vector<std::pair<std::string, double>> TickProfiler::SummarizeCounters(double window)
+{
+    int64_t since = std::max(Now() - (int64_t)(window * 1e9), clearTime.load());
+    std::vector<std::pair<unsigned int, ProfileEvent>> events = CollectEvents(since);
+    
+    std::map<std::string, std::pair<double, unsigned int>> counters;
+    for(size_t i=0; i<events.size(); ++i)
+        if(events[i].second.duration < 0)
+        {
+            std::pair<double, unsigned int>& agg = counters[std::string(events[i].second.name)];
+            agg.first += events[i].second.value;
+            ++agg.second;
+        }
+    
+    std::vector<std::pair<std::string, double>> summary;
+    for(auto it = counters.begin(); it != counters.end(); ++it)
+        summary.push_back(std::make_pair(it->first, it->second.first/(double)it->second.second));
+    return summary;
+}
+
+bool TickProfiler::ExportChromeTrace(const std::string& filename)
+{
+    std::vector<std::pair<unsigned int, ProfileEvent>> events = CollectEvents(clearTime.load());
+    
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == NULL)
+        return false;
+    
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::unordered_set<unsigned int> threads;
+    for(size_t i=0; i<events.size(); ++i)
+        threads.insert(events[i].first);
+    bool first = true;
+    for(auto it = threads.begin(); it != threads.end(); ++it)
+    {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", 
+                first ? "" : ",\n", *it, *it);
+        first = false;
+    }
+    for(size_t i=0; i<events.size(); ++i)
+    {
+        const ProfileEvent& e = events[i].second;
+        if(e.duration < 0)
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%g}}",
+                    first ? "" : ",\n", EscapeJSON(e.name).c_str(), e.start/1000.0, events[i].first, e.value);
+        else
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    first ? "" : ",\n", EscapeJSON(e.name).c_str(), e.parent != nullptr ? EscapeJSON(e.parent).c_str() : "root",
+                    e.start/1000.0, e.duration/1000.0, events[i].first);
+        first = false;
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+}
@@ -4,6 +4,6 @@ include(CMakeFindDependencyMacro)
 find_package(OpenGL REQUIRED)
 find_package(SDL2 REQUIRED)
 find_package(Freetype REQUIRED)
-find_package(OpenMP REQUIRED)
+find_package(Threads REQUIRED)
 
 include(${CMAKE_CURRENT_LIST_DIR}/StonefishTargets.cmake)
\ No newline at end of file
@@ -0,0 +1,287 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+//
+//  RegressionTestApp.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "RegressionTestApp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <core/Console.h>
+#include <entities/SolidEntity.h>
+#include <entities/FeatherstoneEntity.h>
+#include <entities/solids/Sphere.h>
+#include <utils/TaskScheduler.h>
+
+#define NUM_STEPS 500
+#define NUM_KERNEL_RUNS 2000
+#define NUM_LOOKUP_RUNS 200000
+
+RegressionTestApp::RegressionTestApp(std::string dataDirPath, RegressionTestManager* sim) 
+    : ConsoleSimulationApp("Regression Test", dataDirPath, sim), manager(sim)
+{
+}
+
+bool RegressionTestApp::RunChecks()
+{
+    Init();
+    
+    bool passed = true;
+    passed &= CheckThreadIndependence();
+    passed &= CheckSnapshotRoundTrip();
+    passed &= CheckHydrodynamicsKernel();
+    passed &= CheckLinkVelocities();
+    passed &= CheckCollisionLookup();
+    
+    if(passed)
+        cInfo("All checks passed.");
+    else
+        cError("Some checks failed!");
+    return passed;
+}
+
+bool RegressionTestApp::Compare(const char* name, const std::vector<sf::Scalar>& a, const std::vector<sf::Scalar>& b, sf::Scalar tolerance)
+{
+    if(a.size() != b.size() || a.empty())
+    {
+        cError("[FAIL] %s: state sizes differ (%d vs %d).", name, (int)a.size(), (int)b.size());
+        return false;
+    }
+    
+    sf::Scalar maxError(0);
+    for(size_t i=0; i<a.size(); ++i)
+    {
+        sf::Scalar scale = std::max(std::max(btFabs(a[i]), btFabs(b[i])), sf::Scalar(1));
+        maxError = std::max(maxError, btFabs(a[i] - b[i])/scale);
+    }
+    
+    if(maxError > tolerance)
+    {
+        cError("[FAIL] %s: maximum relative error %1.3e exceeds %1.3e.", name, maxError, tolerance);
+        return false;
+    }
+    cInfo("[PASS] %s: maximum relative error %1.3e.", name, maxError);
+    return true;
+}
+
+//The forces are computed in parallel into per-body buffers, so the result cannot depend on the number of threads
+bool RegressionTestApp::CheckThreadIndependence()
+{
+    unsigned int numThreads = sf::TaskScheduler::getNumOfThreads();
+    unsigned int threads[2] = {1, std::max(numThreads, 4u)};
+    std::vector<sf::Scalar> state[2];
+    
+    for(int k=0; k<2; ++k)
+    {
+        sf::TaskScheduler::Init(threads[k]);
+        manager->RestartScenario();
+        manager->StartSimulation();
+        manager->StepSimulation(NUM_STEPS);
+        state[k] = manager->RecordState();
+    }
+    sf::TaskScheduler::Init(numThreads);
+    
+    return Compare("Serial and parallel step", state[0], state[1], sf::Scalar(0));
+}
+
+//Stepping from a restored snapshot has to repeat the original steps exactly (including sensor noise)
+bool RegressionTestApp::CheckSnapshotRoundTrip()
+{
+    manager->RestartScenario();
+    manager->StartSimulation();
+    manager->StepSimulation(NUM_STEPS/5);
+    
+    sf::SimulationSnapshot snapshot;
+    manager->SaveSnapshot(snapshot);
+    manager->StepSimulation(NUM_STEPS);
+    std::vector<sf::Scalar> original = manager->RecordState();
+    
+    if(!manager->RestoreSnapshot(snapshot))
+    {
+        cError("[FAIL] Snapshot round trip: snapshot could not be restored.");
+        return false;
+    }
+    manager->StepSimulation(NUM_STEPS);
+    std::vector<sf::Scalar> replayed = manager->RecordState();
+    
+    return Compare("Snapshot round trip", original, replayed, sf::Scalar(0));
+}
+
+//The vectorised drag kernel performs the float operations of the reference mesh path in a different order
+bool RegressionTestApp::CheckHydrodynamicsKernel()
+{
+    manager->RestartScenario();
+    manager->StartSimulation();
+    
+    sf::SolidEntity* body = dynamic_cast<sf::SolidEntity*>(manager->getEntity("Duct"));
+    if(body == nullptr || body->getPhysicsMesh() == nullptr || body->getHydroMesh() == nullptr)
+    {
+        cError("[FAIL] Hydrodynamics kernel: test body not found.");
+        return false;
+    }
+    
+    const sf::Mesh* mesh = body->getPhysicsMesh();
+    const sf::HydroMesh* hmesh = body->getHydroMesh();
+    sf::Ocean* ocn = manager->getOcean();
+    sf::Transform T_CG = body->getCGTransform();
+    sf::Transform T_C = body->getCTransform();
+    sf::Vector3 v(1.0, -0.5, 0.3);
+    sf::Vector3 omega(0.2, 0.1, -0.3);
+    sf::Vector3 F[2][4];
+    
+    sf::SolidEntity::ComputeHydrodynamicForcesSubmerged(mesh, ocn, T_CG, T_C, v, omega, F[0][0], F[0][1], F[0][2], F[0][3]);
+    sf::SolidEntity::ComputeHydrodynamicForcesSubmerged(hmesh, ocn, T_CG, T_C, v, omega, F[1][0], F[1][1], F[1][2], F[1][3]);
+    
+    std::vector<sf::Scalar> result[2];
+    for(int k=0; k<2; ++k)
+        for(int i=0; i<4; ++i)
+            for(int j=0; j<3; ++j)
+                result[k].push_back(F[k][i][j]);
+    bool passed = Compare("Vectorised hydrodynamics kernel", result[0], result[1], sf::Scalar(1e-3));
+    
+    //Timing (informative only)
+    double time[2];
+    for(int k=0; k<2; ++k)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned int i=0; i<NUM_KERNEL_RUNS; ++i)
+        {
+            if(k == 0)
+                sf::SolidEntity::ComputeHydrodynamicForcesSubmerged(mesh, ocn, T_CG, T_C, v, omega, F[0][0], F[0][1], F[0][2], F[0][3]);
+            else
+                sf::SolidEntity::ComputeHydrodynamicForcesSubmerged(hmesh, ocn, T_CG, T_C, v, omega, F[1][0], F[1][1], F[1][2], F[1][3]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        time[k] = std::chrono::duration<double, std::micro>(end - start).count()/(double)NUM_KERNEL_RUNS;
+    }
+    cInfo("Hydrodynamics kernel (%lu faces): reference %1.2lf us, vectorised %1.2lf us, speedup %1.2lfx", 
+          (unsigned long)hmesh->nFaces, time[0], time[1], time[0]/time[1]);
+    
+    return passed;
+}
+
+//The link velocities cached after each step have to match the motion of the links in the next step
+bool RegressionTestApp::CheckLinkVelocities()
+{
+    manager->RestartScenario();
+    manager->StartSimulation();
+    manager->StepSimulation(NUM_STEPS/5);
+    
+    sf::FeatherstoneEntity* fe = nullptr;
+    sf::Entity* ent;
+    for(unsigned int i=0; (ent = manager->getEntity(i)) != nullptr && fe == nullptr; ++i)
+        if(ent->getType() == sf::EntityType::FEATHERSTONE)
+            fe = (sf::FeatherstoneEntity*)ent;
+    if(fe == nullptr)
+    {
+        cError("[FAIL] Link velocities: test multibody not found.");
+        return false;
+    }
+    
+    std::vector<sf::Transform> T0;
+    for(unsigned int l=0; l<fe->getNumOfLinks(); ++l)
+        T0.push_back(fe->getLink(l).solid->getCGTransform());
+    manager->StepSimulation(1);
+    sf::Scalar dt = sf::Scalar(1)/manager->getStepsPerSecond();
+    
+    //Positions are integrated with the velocities computed in the same step (semi-implicit Euler)
+    std::vector<sf::Scalar> cached, estimated;
+    for(unsigned int l=0; l<fe->getNumOfLinks(); ++l)
+    {
+        sf::SolidEntity* link = fe->getLink(l).solid;
+        sf::Transform T1 = link->getCGTransform();
+        sf::Vector3 v = (T1.getOrigin() - T0[l].getOrigin())/dt;
+        sf::Quaternion dq = T1.getRotation() * T0[l].getRotation().inverse();
+        if(dq.getW() < sf::Scalar(0))
+            dq = -dq;
+        sf::Vector3 w = dq.getAngle() > SIMD_EPSILON ? dq.getAxis() * dq.getAngle()/dt : sf::V0();
+        
+        for(int i=0; i<3; ++i)
+        {
+            cached.push_back(link->getLinearVelocity()[i]);
+            cached.push_back(link->getAngularVelocity()[i]);
+            estimated.push_back(v[i]);
+            estimated.push_back(w[i]);
+        }
+    }
+    
+    return Compare("Cached link velocities", cached, estimated, sf::Scalar(5e-3));
+}
+
+//Collision rules are found through a hash index, so the cost of a lookup should not grow with the number of rules
+bool RegressionTestApp::CheckCollisionLookup()
+{
+    //Rules are kept in a separate (inclusive) manager, so that the scenario is not affected and adding them is silent
+    RegressionTestManager rules(manager->getStepsPerSecond(), sf::CollisionFilteringType::COLLISION_INCLUSIVE);
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SUBMERGED;
+    phy.collisions = false;
+    phy.buoyancy = false;
+    std::vector<sf::Entity*> bodies;
+    for(unsigned int i=0; i<46; ++i) //46*45/2 = 1035 pairs
+        bodies.push_back(new sf::Sphere("Dummy" + std::to_string(i), phy, 0.1, sf::I4(), "Neutral", ""));
+    
+    std::vector<std::pair<const sf::Entity*, const sf::Entity*>> pairs;
+    for(size_t i=0; i<bodies.size(); ++i)
+        for(size_t j=i+1; j<bodies.size(); ++j)
+            pairs.push_back(std::make_pair(bodies[i], bodies[j]));
+    
+    bool passed = true;
+    size_t numRules = 0;
+    size_t sizes[3] = {10, 100, 1000};
+    for(int k=0; k<3; ++k)
+    {
+        for(; numRules < sizes[k]; ++numRules)
+            rules.EnableCollision(pairs[numRules].first, pairs[numRules].second);
+        
+        //Existing rules have to be found in both orders and missing ones must not
+        for(size_t i=0; i<pairs.size(); ++i)
+        {
+            int id = rules.CheckCollision(pairs[i].second, pairs[i].first);
+            if((i < numRules) != (id > -1) || id != rules.CheckCollision(pairs[i].first, pairs[i].second))
+            {
+                cError("[FAIL] Collision lookup: wrong result for rule %d with %d rules.", (int)i, (int)numRules);
+                passed = false;
+                break;
+            }
+        }
+        
+        //Timing (informative only, half of the queries hit a rule)
+        long long found = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned int i=0; i<NUM_LOOKUP_RUNS; ++i)
+        {
+            size_t p = (i % 2 == 0) ? (i/2) % numRules : numRules + (i/2) % (pairs.size() - numRules);
+            found += rules.CheckCollision(pairs[p].first, pairs[p].second) > -1 ? 1 : 0;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration<double, std::nano>(end - start).count()/(double)NUM_LOOKUP_RUNS;
+        cInfo("Collision lookup (%d rules): %1.1lf ns per query (%lld hits)", (int)numRules, time, found);
+    }
+    
+    for(size_t i=0; i<bodies.size(); ++i)
+        delete bodies[i];
+    
+    if(passed)
+        cInfo("[PASS] Collision lookup: rules found with 10, 100 and 1000 rules.");
+    return passed;
+}
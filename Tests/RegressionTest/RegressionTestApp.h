@@ -0,0 +1,54 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+//
+//  RegressionTestApp.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish__RegressionTestApp__
+#define __Stonefish__RegressionTestApp__
+
+#include <core/ConsoleSimulationApp.h>
+#include "RegressionTestManager.h"
+
+//! A console application checking the invariants of the simulation (run by ctest).
+class RegressionTestApp : public sf::ConsoleSimulationApp
+{
+public:
+    RegressionTestApp(std::string dataDirPath, RegressionTestManager* sim);
+    
+    //! A method building the scenario and running all checks.
+    /*!
+     \return true if all checks passed
+     */
+    bool RunChecks();
+    
+private:
+    bool CheckThreadIndependence();
+    bool CheckSnapshotRoundTrip();
+    bool CheckHydrodynamicsKernel();
+    bool CheckLinkVelocities();
+    bool CheckCollisionLookup();
+    bool Compare(const char* name, const std::vector<sf::Scalar>& a, const std::vector<sf::Scalar>& b, sf::Scalar tolerance);
+    
+    RegressionTestManager* manager;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RegressionTestManager.cpp
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "RegressionTestManager.h"
+
+#include <core/FeatherstoneRobot.h>
+#include <entities/FeatherstoneEntity.h>
+#include <entities/solids/Box.h>
+#include <entities/solids/Sphere.h>
+#include <entities/solids/Cylinder.h>
+#include <entities/solids/Polyhedron.h>
+#include <entities/solids/Compound.h>
+#include <entities/forcefields/Uniform.h>
+#include <actuators/Thruster.h>
+#include <actuators/Servo.h>
+#include <sensors/ScalarSensor.h>
+#include <sensors/scalar/IMU.h>
+#include <sensors/scalar/Odometry.h>
+#include <sensors/scalar/Pressure.h>
+#include <utils/UnitSystem.h>
+#include <utils/SystemUtil.hpp>
+
+RegressionTestManager::RegressionTestManager(sf::Scalar stepsPerSecond, sf::CollisionFilteringType cft) 
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, cft)
+{
+}
+
+void RegressionTestManager::BuildScenario()
+{
+    setRandomSeed(17);
+    
+    CreateMaterial("Neutral", sf::UnitSystem::Density(sf::CGS, sf::MKS, 1.0), 0.5);
+    CreateMaterial("Light", sf::UnitSystem::Density(sf::CGS, sf::MKS, 0.5), 0.5);
+    SetMaterialsInteraction("Neutral", "Neutral", 0.5, 0.2);
+    SetMaterialsInteraction("Light", "Light", 0.5, 0.2);
+    SetMaterialsInteraction("Neutral", "Light", 0.5, 0.2);
+    
+    //Calm water with a current
+    EnableOcean(0.0);
+    getOcean()->AddVelocityField(new sf::Uniform(sf::Vector3(0.3, 0.1, 0.0)));
+    getOcean()->EnableCurrents();
+    
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SUBMERGED;
+    phy.collisions = false;
+    phy.buoyancy = true;
+    
+    //Free bodies -> submerged mesh and a body crossing the surface
+    sf::Polyhedron* duct = new sf::Polyhedron("Duct", phy, sf::GetDataPath() + "duct_hydro.obj", sf::Scalar(1), sf::I4(), "Neutral", "");
+    AddSolidEntity(duct, sf::Transform(sf::Quaternion(0.3, 0.2, 0.1), sf::Vector3(2.0, 0.0, 3.0)));
+    
+    sf::BodyPhysicsSettings phyFloat = phy;
+    phyFloat.mode = sf::BodyPhysicsMode::FLOATING;
+    sf::Sphere* ball = new sf::Sphere("Ball", phyFloat, 0.2, sf::I4(), "Light", "");
+    AddSolidEntity(ball, sf::Transform(sf::IQ(), sf::Vector3(-2.0, 0.0, 0.05)));
+    
+    //Vehicle with an arm
+    sf::Cylinder* hull = new sf::Cylinder("Hull", phy, 0.15, 1.0, sf::I4(), "Neutral", "");
+    sf::Polyhedron* shroud = new sf::Polyhedron("Shroud", phy, sf::GetDataPath() + "duct_hydro.obj", sf::Scalar(1), sf::I4(), "Neutral", "");
+    sf::Compound* vehicle = new sf::Compound("Vehicle", phy, hull, sf::Transform(sf::Quaternion(0, M_PI_2, 0), sf::V0()));
+    vehicle->AddExternalPart(shroud, sf::Transform(sf::IQ(), sf::Vector3(-0.6, 0.0, 0.0)));
+    
+    std::vector<sf::SolidEntity*> arm;
+    arm.push_back(new sf::Box("Link1", phy, sf::Vector3(0.4, 0.05, 0.05), sf::Transform(sf::IQ(), sf::Vector3(0.2, 0.0, 0.0)), "Neutral", ""));
+    arm.push_back(new sf::Box("Link2", phy, sf::Vector3(0.3, 0.05, 0.05), sf::Transform(sf::IQ(), sf::Vector3(0.15, 0.0, 0.0)), "Neutral", ""));
+    
+    sf::Polyhedron* prop = new sf::Polyhedron("Propeller", phy, sf::GetDataPath() + "propeller.obj", sf::Scalar(1), sf::I4(), "Neutral", "");
+    sf::Thruster* thruster = new sf::Thruster("Thruster", prop, 0.18, std::make_pair(0.48, 0.48), 0.05, 1000.0, true);
+    thruster->setSetpoint(0.4);
+    
+    sf::Servo* srv1 = new sf::Servo("Servo1", 1.0, 1.0, 10.0);
+    srv1->setControlMode(sf::ServoControlMode::VELOCITY);
+    srv1->setDesiredVelocity(0.5);
+    sf::Servo* srv2 = new sf::Servo("Servo2", 1.0, 1.0, 10.0);
+    srv2->setControlMode(sf::ServoControlMode::VELOCITY);
+    srv2->setDesiredVelocity(-0.3);
+    
+    sf::IMU* imu = new sf::IMU("IMU");
+    imu->setNoise(sf::V0(), sf::Vector3(0.05, 0.05, 0.1), 0.0, sf::Vector3(0.01, 0.01, 0.02));
+    sf::Pressure* press = new sf::Pressure("Pressure");
+    press->setNoise(1.0);
+    sf::Odometry* odom = new sf::Odometry("Odometry");
+    
+    sf::Robot* auv = new sf::FeatherstoneRobot("AUV", false);
+    auv->DefineLinks(vehicle, arm);
+    auv->DefineRevoluteJoint("Joint1", "Vehicle", "Link1", sf::Transform(sf::IQ(), sf::Vector3(0.55, 0.0, 0.0)), sf::VZ(), std::make_pair(-1.0, 1.0));
+    auv->DefineRevoluteJoint("Joint2", "Link1", "Link2", sf::Transform(sf::IQ(), sf::Vector3(0.4, 0.0, 0.0)), sf::VY(), std::make_pair(-1.0, 1.0));
+    auv->BuildKinematicStructure();
+    auv->AddJointActuator(srv1, "Joint1");
+    auv->AddJointActuator(srv2, "Joint2");
+    auv->AddLinkActuator(thruster, "Vehicle", sf::Transform(sf::IQ(), sf::Vector3(-0.6, 0.0, 0.0)));
+    auv->AddLinkSensor(imu, "Vehicle", sf::I4());
+    auv->AddLinkSensor(press, "Vehicle", sf::Transform(sf::IQ(), sf::Vector3(0.3, 0.0, -0.15)));
+    auv->AddLinkSensor(odom, "Vehicle", sf::I4());
+    AddRobot(auv, sf::Transform(sf::Quaternion(0.0, 0.0, 0.2), sf::Vector3(0.0, 0.0, 2.0)));
+}
+
+static void RecordBody(const sf::SolidEntity* solid, std::vector<sf::Scalar>& state)
+{
+    sf::Transform T = solid->getCGTransform();
+    sf::Vector3 v = solid->getLinearVelocity();
+    sf::Vector3 w = solid->getAngularVelocity();
+    for(int i=0; i<3; ++i)
+        state.push_back(T.getOrigin()[i]);
+    for(int i=0; i<4; ++i)
+        state.push_back(T.getRotation()[i]);
+    for(int i=0; i<3; ++i)
+        state.push_back(v[i]);
+    for(int i=0; i<3; ++i)
+        state.push_back(w[i]);
+}
+
+std::vector<sf::Scalar> RegressionTestManager::RecordState()
+{
+    std::vector<sf::Scalar> state;
+    sf::Entity* ent;
+    for(unsigned int i=0; (ent = getEntity(i)) != nullptr; ++i)
+    {
+        if(ent->getType() == sf::EntityType::SOLID)
+            RecordBody((sf::SolidEntity*)ent, state);
+        else if(ent->getType() == sf::EntityType::FEATHERSTONE)
+        {
+            sf::FeatherstoneEntity* fe = (sf::FeatherstoneEntity*)ent;
+            for(unsigned int l=0; l<fe->getNumOfLinks(); ++l)
+                RecordBody(fe->getLink(l).solid, state);
+        }
+    }
+    
+    sf::Sensor* sens;
+    for(unsigned int i=0; (sens = getSensor(i)) != nullptr; ++i)
+    {
+        sf::ScalarSensor* ss = dynamic_cast<sf::ScalarSensor*>(sens);
+        if(ss == nullptr)
+            continue;
+        for(unsigned short ch=0; ch<ss->getNumOfChannels(); ++ch)
+            state.push_back(ss->getLastValue(ch));
+    }
+    return state;
+}
@@ -0,0 +1,43 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RegressionTestManager.h
+//  Stonefish
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#ifndef __Stonefish__RegressionTestManager__
+#define __Stonefish__RegressionTestManager__
+
+#include <core/SimulationManager.h>
+
+//! A scenario exercising the hydrodynamics, multibody dynamics, actuators and noisy sensors, without contacts.
+class RegressionTestManager : public sf::SimulationManager
+{
+public:
+    RegressionTestManager(sf::Scalar stepsPerSecond, sf::CollisionFilteringType cft = sf::CollisionFilteringType::COLLISION_EXCLUSIVE);
+    
+    void BuildScenario();
+    
+    //! A method returning the poses and velocities of all bodies and the last measurements of all scalar sensors.
+    std::vector<sf::Scalar> RecordState();
+};
+
+#endif
@@ -0,0 +1,34 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  RegressionTest
+//
+//  Created by Stonefish contributors on 18/10/2026.
+//  Copyright (c) 2026 Stonefish contributors. All rights reserved.
+//
+
+#include "RegressionTestApp.h"
+#include "RegressionTestManager.h"
+
+int main(int argc, const char * argv[])
+{
+    RegressionTestManager* simulationManager = new RegressionTestManager(500.0);
+    RegressionTestApp app(std::string(DATA_DIR_PATH), simulationManager);
+    return app.RunChecks() ? 0 : 1;
+}